@@ -0,0 +1,171 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+
+static int		BatchLine(char *sLine, struct TURING *pJob);
+static int		BatchAutoBits(FILE *fp);
+
+
+// *******************************************************************
+// With -f, we read the jobs from a file (or from stdin, if the file
+// name is "-").  Each line is a 't' value, optionally followed by
+// its own -g and/or -c values, such as:
+//
+//		7005.06 -g 4 -c 32
+//
+// Blank lines and lines beginning with '#' are skipped.  Every other
+// command line parameter applies to all the jobs.  The MPFR system,
+// the Hardy Z coefficients and the gList MPFR variables are set up
+// once, and reused by each job.  We return 1 if every job succeeded.
+// *******************************************************************
+int ComputeBatch(struct TURING tur)
+{
+FILE			*fp;
+char			sLine[TUR_BATCH_LINE_MAX];
+struct TURING	Job;
+struct TURCTX *	ctx;
+int				Line = 0, Jobs = 0, Failed = 0, Result;
+
+if(strcmp(tur.BatchFile, "-") == 0) {
+	fp = stdin;
+	}
+else if((fp = fopen(tur.BatchFile, "r")) == NULL) {
+	printf("Unable to open batch file %s \n", tur.BatchFile);
+	return(0);
+	}
+
+// -------------------------------------------------------------------
+// With -b auto, the bits must suit every job, so we read the file
+// through once first.  We cannot do that with stdin, where we keep
+// the default bits.
+// -------------------------------------------------------------------
+if(tur.AutoBits == true && fp != stdin) {
+	tur.DefaultBits = BatchAutoBits(fp);
+	printf("MPFR precision (-b auto): %d bits \n\n", tur.DefaultBits);
+	}
+
+TuringOpen(tur);
+if((ctx = TuringCtxNew(HGT_TUR_GRAM_PTS_MAX, HGT_TUR_SUBINTVL_MAX)) == NULL) {
+	TuringClose();
+	if(fp != stdin) {
+		fclose(fp);
+		}
+	return(0);
+	}
+while(fgets(sLine, sizeof(sLine), fp) != NULL) {
+	Line++;
+	Job = tur;
+	if((Result = BatchLine(sLine, &Job)) == 0) {
+		continue;
+		}
+	Jobs++;
+	if(Result > 0 && Job.ZeroDigits > ZeroDigitsMax(Job.DefaultBits, AutoEnd(Job))) {
+		Result = -1;
+		}
+	if(Result < 0) {
+		printf("Batch job %d (line %d): invalid line, skipped \n\n", Jobs, Line);
+		Failed++;
+		continue;
+		}
+	printf("Batch job %d (line %d): t = %s, -g %d, -c %d \n\n", Jobs, Line, Job.tBuf,
+		Job.CountGram, Job.CountZ);
+	if(Job.Workers > Job.CountGram + 2) {
+		printf("Batch job %d: -w %d is more than the %d tasks in a window, so only %d workers are used \n\n",
+			Jobs, Job.Workers, Job.CountGram + 2, Job.CountGram + 2);
+		}
+	if(TuringJob(ctx, Job) < 1) {
+		Failed++;
+		}
+	printf("\n");
+	}
+TuringCtxFree(ctx);
+TuringClose();
+if(fp != stdin) {
+	fclose(fp);
+	}
+
+printf("Batch complete: %d jobs, %d failed \n", Jobs, Failed);
+return((Jobs > 0 && Failed == 0) ? 1 : 0);
+}
+
+
+// *******************************************************************
+// We parse one line of the batch file into pJob (which starts as a
+// copy of the command line values).  We return 0 for a blank or
+// comment line, -1 for an invalid line, and 1 otherwise.
+// *******************************************************************
+static int BatchLine(char *sLine, struct TURING *pJob)
+{
+char	*sToken, *sValue;
+int		tDecimalDigits;
+
+sToken = strtok(sLine, " \t\r\n");
+if(sToken == NULL || *sToken == '#') {
+	return(0);
+	}
+if(strlen(sToken) >= HGT_MAX_CMDLINE_STRLEN || ValidateHardyT(sToken) < 1) {
+	return(-1);
+	}
+strcpy(pJob->tBuf, sToken);
+tDecimalDigits = GetDecimalDigits(pJob->tBuf);
+if(tDecimalDigits > pJob->OutputDP) {
+	pJob->OutputDP = tDecimalDigits;
+	}
+
+while((sToken = strtok(NULL, " \t\r\n")) != NULL) {
+	if((sValue = strtok(NULL, " \t\r\n")) == NULL) {
+		return(-1);
+		}
+	if(strcmp(sToken, "-g") == 0) {
+		pJob->CountGram = ValidateTuringGramPoints(sValue);
+		}
+	else if(strcmp(sToken, "-c") == 0) {
+		pJob->CountZ = ValidateTuringSubIntervals(sValue);
+		}
+	else {
+		return(-1);
+		}
+	if(pJob->CountGram < 1 || pJob->CountZ < 1) {
+		return(-1);
+		}
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// With -b auto, we return the bits needed by the largest job 't' in
+// the batch file, and rewind the file.
+// *******************************************************************
+static int BatchAutoBits(FILE *fp)
+{
+char			sLine[TUR_BATCH_LINE_MAX];
+struct TURING	Job;
+int				Bits, MaxBits = 128;
+
+memset(&Job, 0, sizeof(Job));
+while(fgets(sLine, sizeof(sLine), fp) != NULL) {
+	Job.CountGram = Job.CountZ = 1;
+	if(BatchLine(sLine, &Job) == 1) {
+		Bits = AutoPrecision(Job.tBuf, AutoEnd(Job));
+		MaxBits = Bits > MaxBits ? Bits : MaxBits;
+		}
+	}
+rewind(fp);
+return(MaxBits);
+}
@@ -0,0 +1,199 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+#include "turbin.h"
+
+extern struct	HGT_INIT	hgt_init;
+
+static int		BinOpen(struct TURCTX *ctx, struct TURING tur);
+static int		BinRecord(struct TURBINRECORD *pRec, uint64_t n, uint32_t Sub,
+					double tOffset, struct HARDYINFO *pInfo, uint32_t Flags);
+
+
+// *******************************************************************
+// With -B, we write the samples of the current window to the binary
+// sample file (see turbin.h).  The window's records are built in
+// ctx->BinRec and written together at their position in the file, so
+// a resumed run (-r) simply carries on, and the Gram point that ends
+// one window and begins the next is written twice with the same data.
+// *******************************************************************
+int BinWindow(struct TURCTX *ctx, struct TURING tur)
+{
+mpfr_t		t;
+uint64_t	First, n;
+uint32_t	Flags;
+double		Base, Len;
+int			i, j, idx, Count;
+
+if(ctx->BinFailed == true || (ctx->fpBin == NULL && BinOpen(ctx, tur) < 1)) {
+	ctx->BinFailed = true;
+	return(0);
+	}
+mpfr_inits2 (hgt_init.DefaultBits, t, (mpfr_ptr) 0);
+
+// -------------------------------------------------------------------
+// The sample before the first Gram point (first window only), which
+// is record 0, just before the window's own records.
+// -------------------------------------------------------------------
+First = 1 + (ctx->sweep.Done * (uint64_t) ctx->CountZ);
+Count = 0;
+if(ctx->sweep.Done == 0) {
+	n = mpfr_get_uj (ctx->gList[0].n, MPFR_RNDN);
+	mpfr_sub (t, ctx->tBefore, ctx->BinBase, MPFR_RNDN);
+	BinRecord(&ctx->BinRec[Count++], n - 1, ctx->CountZ - 1, mpfr_get_d (t, MPFR_RNDN),
+		&ctx->hInfo[0], TURBIN_BEFORE);
+	First = 0;
+	}
+
+// -------------------------------------------------------------------
+// The samples of each Gram interval, then the Gram point after the
+// last interval.  Only the offset of each Gram point is taken in
+// MPFR; the offsets of its samples follow in double, as tOffset is
+// only a double.
+// -------------------------------------------------------------------
+for(i=0; i <= tur.CountGram; i++) {
+	n = mpfr_get_uj (ctx->gList[i].n, MPFR_RNDN);
+	mpfr_sub (t, ctx->gList[i].Gram, ctx->BinBase, MPFR_RNDN);
+	Base = mpfr_get_d (t, MPFR_RNDN);
+	Len  = i < tur.CountGram ? mpfr_get_d (ctx->gList[i].lenSubInterval, MPFR_RNDN) : 0;
+	for(j = 0; j < (i < tur.CountGram ? ctx->CountZ : 1); j++) {
+		idx = (i * ctx->CountZ) + 1 + j;
+		Flags = 0;
+		if(j == 0 && ctx->gList[i].Good == true) {
+			Flags |= TURBIN_GRAMGOOD;
+			}
+		BinRecord(&ctx->BinRec[Count++], n, j, Base + (j * Len), &ctx->hInfo[idx], Flags);
+		}
+	}
+
+fseeko(ctx->fpBin, (off_t) (sizeof(struct TURBINHEADER) + (First * sizeof(struct TURBINRECORD))), SEEK_SET);
+fwrite(ctx->BinRec, sizeof(struct TURBINRECORD), Count, ctx->fpBin);
+fflush(ctx->fpBin);
+mpfr_clears (t, (mpfr_ptr) 0);
+return(1);
+}
+
+
+// *******************************************************************
+// We close the binary sample file (if open).  If the run ended early
+// (with -R, or when asked to stop), the header is updated so that it
+// describes only the Gram intervals actually written.
+// *******************************************************************
+int BinClose(struct TURCTX *ctx)
+{
+struct TURBINHEADER	Header;
+
+if(ctx->fpBin != NULL) {
+	if(fseeko(ctx->fpBin, 0, SEEK_SET) == 0 && fread(&Header, sizeof(Header), 1, ctx->fpBin) == 1
+		&& Header.CountGram != ctx->sweep.Done) {
+		Header.CountGram	= ctx->sweep.Done;
+		Header.CountRecords	= (ctx->sweep.Done * (uint64_t) Header.CountZ) + 2;
+		fseeko(ctx->fpBin, 0, SEEK_SET);
+		fwrite(&Header, sizeof(Header), 1, ctx->fpBin);
+		}
+	fclose(ctx->fpBin);
+	ctx->fpBin = NULL;
+	free(ctx->BinRec);
+	ctx->BinRec = NULL;
+	mpfr_clears (ctx->BinBase, (mpfr_ptr) 0);
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// We open the binary sample file.  For a new run we write the header
+// (the first window's gList[0] is g(StartN)).  On resume, we keep the
+// file and read g(StartN) back from its header.
+// *******************************************************************
+static int BinOpen(struct TURCTX *ctx, struct TURING tur)
+{
+struct TURBINHEADER	Header;
+
+if((ctx->BinRec = malloc(((ctx->MaxGram * ctx->MaxCountZ) + 2) * sizeof(struct TURBINRECORD))) == NULL) {
+	fprintf(stderr, "Unable to allocate the binary sample records \n");
+	return(0);
+	}
+mpfr_inits2 (hgt_init.DefaultBits, ctx->BinBase, (mpfr_ptr) 0);
+if(tur.Resume == true) {
+	if((ctx->fpBin = fopen(tur.BinFile, "r+b")) == NULL
+		|| fread(&Header, sizeof(Header), 1, ctx->fpBin) != 1
+		|| memcmp(Header.Magic, TURBIN_MAGIC, sizeof(Header.Magic)) != 0) {
+		fprintf(stderr, "Unable to resume the binary sample file %s \n", tur.BinFile);
+		if(ctx->fpBin != NULL) {
+			fclose(ctx->fpBin);
+			ctx->fpBin = NULL;
+			}
+		free(ctx->BinRec);
+		ctx->BinRec = NULL;
+		mpfr_clears (ctx->BinBase, (mpfr_ptr) 0);
+		return(0);
+		}
+	mpfr_set_str (ctx->BinBase, Header.sBaseT, 0, MPFR_RNDN);
+	return(1);
+	}
+
+if((ctx->fpBin = fopen(tur.BinFile, "w+b")) == NULL) {
+	fprintf(stderr, "Unable to write binary sample file %s \n", tur.BinFile);
+	free(ctx->BinRec);
+	ctx->BinRec = NULL;
+	mpfr_clears (ctx->BinBase, (mpfr_ptr) 0);
+	return(0);
+	}
+memset(&Header, 0, sizeof(Header));
+memcpy(Header.Magic, TURBIN_MAGIC, sizeof(Header.Magic));
+Header.Version		= TURBIN_VERSION;
+Header.HeaderSize	= sizeof(struct TURBINHEADER);
+Header.RecordSize	= sizeof(struct TURBINRECORD);
+Header.Bits			= (uint32_t) tur.DefaultBits;
+Header.CountZ		= (uint32_t) tur.CountZ;
+Header.StartN		= mpfr_get_uj (ctx->gList[0].n, MPFR_RNDN);
+Header.CountGram	= ctx->sweep.Total;
+Header.CountRecords	= (ctx->sweep.Total * (uint64_t) tur.CountZ) + 2;
+
+// -------------------------------------------------------------------
+// The base is written exactly (in hex), so the first Gram point's
+// tOffset is exactly 0, and a resumed run (which reads the text back)
+// uses exactly the same base.
+// -------------------------------------------------------------------
+mpfr_set (ctx->BinBase, ctx->gList[0].Gram, MPFR_RNDN);
+mpfr_snprintf(Header.sBaseT, sizeof(Header.sBaseT), "%Ra", ctx->BinBase);
+Header.BaseT		= mpfr_get_d (ctx->BinBase, MPFR_RNDN);
+fwrite(&Header, sizeof(Header), 1, ctx->fpBin);
+return(1);
+}
+
+
+// *******************************************************************
+// We fill in one record.
+// *******************************************************************
+static int BinRecord(struct TURBINRECORD *pRec, uint64_t n, uint32_t Sub,
+	double tOffset, struct HARDYINFO *pInfo, uint32_t Flags)
+{
+memset(pRec, 0, sizeof(struct TURBINRECORD));
+pRec->n			= n;
+pRec->Sub		= Sub;
+pRec->Flags		= Flags
+			| (pInfo->ZeroCross  == true ? TURBIN_ZEROCROSS  : 0)
+			| (pInfo->TowardZero == true ? TURBIN_TOWARDZERO : 0)
+			| (pInfo->Lehmer     == true ? TURBIN_LEHMER     : 0);
+pRec->tOffset	= tOffset;
+pRec->hzValue	= pInfo->hzValue;
+pRec->hzRise	= pInfo->hzRise;
+return(1);
+}
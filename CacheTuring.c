@@ -0,0 +1,538 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <mpfr.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "hgt.h"
+#include "turing.h"
+#include "turcache.h"
+
+extern struct	HGT_INIT	hgt_init;
+
+struct CACHESLOT {
+	struct TURCACHERECORD	Key;	// Key.Check is unused here
+	uint64_t				Data;	// offset of the record's data
+};
+
+static pthread_mutex_t		CacheLock = PTHREAD_MUTEX_INITIALIZER;
+static FILE *				fpCache = NULL;
+static const char *			pMap = NULL;	// the file as it was when opened (not on Windows)
+static size_t				MapSize = 0;
+static struct CACHESLOT *	Slot = NULL;	// the index: open addressing, linear probing
+static size_t				SlotCount, SlotUsed;
+
+static int			CacheFind(struct TURCACHERECORD *pKey, void *pData);
+static int			CacheAdd(struct TURCACHERECORD *pKey, const void *pData);
+static int			CacheIndex(struct TURCACHERECORD *pKey, uint64_t Data);
+static int			CacheRead(uint64_t Offset, void *pData, size_t Size);
+static uint32_t		CacheCheck(struct TURCACHERECORD *pRec, const void *pData);
+static uint32_t		CacheMode(struct TURING tur);
+static int			CacheFileLock(bool Lock);
+
+
+// *******************************************************************
+// With -H, we open (or create) the cache file, map it, and index its
+// records by key.  If the file ends in a damaged record, we cut it
+// back to the records before it.  We return 0 (after printing why) if
+// the file cannot be used, and the run then goes on without a cache.
+//
+// Several runs may share one cache file (shards on one node, say), so
+// we hold a lock on the file (see CacheFileLock) while we create,
+// index or cut it back, and while we append to it.
+// *******************************************************************
+int CacheOpen(struct TURING tur)
+{
+struct TURCACHEHEADER	Header;
+struct TURCACHERECORD	Rec;
+char					Data[TURCACHE_DATA_MAX];
+uint64_t				Offset, Size;
+#ifndef _WIN32
+int						fd;
+#endif
+
+#ifdef _WIN32
+if((fpCache = fopen(tur.CacheFile, "r+b")) == NULL) {
+	fpCache = fopen(tur.CacheFile, "w+b");
+	}
+#else
+if((fd = open(tur.CacheFile, O_RDWR | O_CREAT, 0644)) >= 0 && (fpCache = fdopen(fd, "r+b")) == NULL) {
+	close(fd);
+	}
+#endif
+if(fpCache == NULL || CacheFileLock(true) == 0) {
+	fprintf(stderr, "Unable to open cache file %s \n", tur.CacheFile);
+	CacheClose();
+	return(0);
+	}
+fseeko(fpCache, 0, SEEK_END);
+Size = (uint64_t) ftello(fpCache);
+if(Size == 0) {
+	memset(&Header, 0, sizeof(Header));
+	memcpy(Header.Magic, TURCACHE_MAGIC, sizeof(Header.Magic));
+	Header.Version = TURCACHE_VERSION;
+	Header.HeaderSize = sizeof(struct TURCACHEHEADER);
+	Header.RecordSize = sizeof(struct TURCACHERECORD);
+	if(fwrite(&Header, sizeof(Header), 1, fpCache) != 1 || fflush(fpCache) != 0) {
+		fprintf(stderr, "Unable to create cache file %s \n", tur.CacheFile);
+		CacheClose();
+		return(0);
+		}
+	Size = sizeof(Header);
+	}
+
+#ifndef _WIN32
+pMap = mmap(NULL, (size_t) Size, PROT_READ, MAP_SHARED, fileno(fpCache), 0);
+if(pMap == MAP_FAILED) {
+	pMap = NULL;
+	}
+else {
+	MapSize = (size_t) Size;
+	}
+#endif
+
+if(CacheRead(0, &Header, sizeof(Header)) == 0
+	|| memcmp(Header.Magic, TURCACHE_MAGIC, sizeof(Header.Magic)) != 0
+	|| Header.Version != TURCACHE_VERSION
+	|| Header.HeaderSize != sizeof(struct TURCACHEHEADER)
+	|| Header.RecordSize != sizeof(struct TURCACHERECORD)) {
+	fprintf(stderr, "The file %s is not a version %d cache file \n", tur.CacheFile, TURCACHE_VERSION);
+	CacheClose();
+	return(0);
+	}
+
+// -------------------------------------------------------------------
+// Index the records, stopping at the first one that is damaged.
+// -------------------------------------------------------------------
+SlotCount = 1024;
+SlotUsed = 0;
+if((Slot = calloc(SlotCount, sizeof(struct CACHESLOT))) == NULL) {
+	CacheClose();
+	return(0);
+	}
+for(Offset = sizeof(Header); Offset + sizeof(Rec) <= Size; Offset += sizeof(Rec) + Rec.Size) {
+	if(CacheRead(Offset, &Rec, sizeof(Rec)) == 0 || Rec.Size > TURCACHE_DATA_MAX
+		|| Offset + sizeof(Rec) + Rec.Size > Size
+		|| CacheRead(Offset + sizeof(Rec), Data, Rec.Size) == 0
+		|| CacheCheck(&Rec, Data) != Rec.Check) {
+		break;
+		}
+	CacheIndex(&Rec, Offset + sizeof(Rec));
+	}
+if(Offset < Size) {
+	fprintf(stderr, "Cache file %s: cut back from %ju to %ju bytes (damaged record) \n",
+		tur.CacheFile, (uintmax_t) Size, (uintmax_t) Offset);
+	fflush(fpCache);
+#ifdef _WIN32
+	_chsize_s(_fileno(fpCache), (__int64) Offset);
+#else
+	if(pMap != NULL) {
+		munmap((void *) pMap, MapSize);
+		pMap = NULL;
+		}
+	if(ftruncate(fileno(fpCache), (off_t) Offset) != 0) {
+		CacheClose();
+		return(0);
+		}
+#endif
+	}
+CacheFileLock(false);
+return(1);
+}
+
+
+// *******************************************************************
+// We close the cache file (if open, which also drops its lock) and
+// free its index.
+// *******************************************************************
+int CacheClose(void)
+{
+#ifndef _WIN32
+if(pMap != NULL) {
+	munmap((void *) pMap, MapSize);
+	}
+#endif
+pMap = NULL;
+MapSize = 0;
+if(fpCache != NULL) {
+	fclose(fpCache);
+	fpCache = NULL;
+	}
+free(Slot);
+Slot = NULL;
+return(1);
+}
+
+
+// *******************************************************************
+// We look up g(n) for gList[i] (whose 'n' is set), and return 1 if it
+// was found, with gList[i].Gram set.  With no cache, we return 0.
+// *******************************************************************
+int CacheGram(struct TURCTX *ctx, struct TURING tur, int i)
+{
+struct TURCACHERECORD	Key;
+char					sGram[TURCACHE_DATA_MAX];
+int						Found;
+
+if(fpCache == NULL) {
+	return(0);
+	}
+memset(&Key, 0, sizeof(Key));
+Key.n = mpfr_get_uj (ctx->gList[i].n, MPFR_RNDN);
+Key.Kind = TURCACHE_GRAM;
+Key.Bits = (uint32_t) tur.DefaultBits;
+Found = CacheFind(&Key, sGram);
+if(Found == 1) {
+	sGram[TURCACHE_DATA_MAX - 1] = '\0';
+	Found = mpfr_set_str (ctx->gList[i].Gram, sGram, 0, MPFR_RNDN) == 0 ? 1 : 0;
+	}
+
+pthread_mutex_lock(&CacheLock);
+ctx->sweep.CacheGramHits += Found;
+ctx->sweep.CacheGramMisses += 1 - Found;
+pthread_mutex_unlock(&CacheLock);
+return(Found);
+}
+
+
+// *******************************************************************
+// We add g(n) for gList[i] to the cache, as the exact "%Ra" text.
+// *******************************************************************
+int CachePutGram(struct TURCTX *ctx, struct TURING tur, int i)
+{
+struct TURCACHERECORD	Key;
+char					sGram[TURCACHE_DATA_MAX];
+int						Len;
+
+if(fpCache == NULL) {
+	return(0);
+	}
+memset(sGram, 0, sizeof(sGram));
+Len = mpfr_snprintf(sGram, sizeof(sGram), "%Ra", ctx->gList[i].Gram);
+if(Len < 0 || Len >= TURCACHE_DATA_MAX - 8) {
+	return(0);
+	}
+memset(&Key, 0, sizeof(Key));
+Key.n = mpfr_get_uj (ctx->gList[i].n, MPFR_RNDN);
+Key.Kind = TURCACHE_GRAM;
+Key.Bits = (uint32_t) tur.DefaultBits;
+Key.Size = (uint32_t) ((Len + 8) & ~7);
+return(CacheAdd(&Key, sGram));
+}
+
+
+// *******************************************************************
+// We look up the CountZ samples of Gram interval i, and return 1 if
+// they were found (and copied to hInfo).  With no cache, we return 0.
+// *******************************************************************
+int CacheInterval(struct TURCTX *ctx, struct TURING tur, int i)
+{
+struct TURCACHERECORD	Key;
+double					hz[TURCACHE_DATA_MAX / sizeof(double)];
+int						j, Found;
+
+if(fpCache == NULL) {
+	return(0);
+	}
+memset(&Key, 0, sizeof(Key));
+Key.n = mpfr_get_uj (ctx->gList[i].n, MPFR_RNDN);
+Key.Kind = TURCACHE_SAMPLES;
+Key.Bits = (uint32_t) tur.DefaultBits;
+Key.CountZ = (uint32_t) ctx->CountZ;
+Key.Mode = CacheMode(tur);
+Key.Size = (uint32_t) (ctx->CountZ * sizeof(double));
+Found = CacheFind(&Key, hz);
+if(Found == 1) {
+	for(j = 0; j < ctx->CountZ; j++) {
+		ctx->hInfo[(i * ctx->CountZ) + 1 + j].hzValue = hz[j];
+		}
+	ctx->gList[i].GridBound = 0;
+	}
+
+pthread_mutex_lock(&CacheLock);
+ctx->sweep.CacheHits += Found;
+ctx->sweep.CacheMisses += 1 - Found;
+pthread_mutex_unlock(&CacheLock);
+return(Found);
+}
+
+
+// *******************************************************************
+// We add the CountZ samples of Gram interval i to the cache.
+// *******************************************************************
+int CachePutInterval(struct TURCTX *ctx, struct TURING tur, int i)
+{
+struct TURCACHERECORD	Key;
+double					hz[TURCACHE_DATA_MAX / sizeof(double)];
+int						j;
+
+if(fpCache == NULL) {
+	return(0);
+	}
+for(j = 0; j < ctx->CountZ; j++) {
+	hz[j] = ctx->hInfo[(i * ctx->CountZ) + 1 + j].hzValue;
+	}
+memset(&Key, 0, sizeof(Key));
+Key.n = mpfr_get_uj (ctx->gList[i].n, MPFR_RNDN);
+Key.Kind = TURCACHE_SAMPLES;
+Key.Bits = (uint32_t) tur.DefaultBits;
+Key.CountZ = (uint32_t) ctx->CountZ;
+Key.Mode = CacheMode(tur);
+Key.Size = (uint32_t) (ctx->CountZ * sizeof(double));
+return(CacheAdd(&Key, hz));
+}
+
+
+// *******************************************************************
+// As CacheInterval, for one of the two samples outside the intervals:
+// idx 0 (the sample before the first Gram point, which depends on
+// CountZ), or the Gram point after the last interval.
+// *******************************************************************
+int CachePoint(struct TURCTX *ctx, struct TURING tur, int idx)
+{
+struct TURCACHERECORD	Key;
+double					hz;
+int						Found;
+
+if(fpCache == NULL) {
+	return(0);
+	}
+memset(&Key, 0, sizeof(Key));
+Key.n = mpfr_get_uj (ctx->gList[idx == 0 ? 0 : (idx - 1) / ctx->CountZ].n, MPFR_RNDN);
+Key.Kind = idx == 0 ? TURCACHE_BEFORE : TURCACHE_POINT;
+Key.Bits = (uint32_t) tur.DefaultBits;
+Key.CountZ = idx == 0 ? (uint32_t) ctx->CountZ : 0;
+Key.Mode = CacheMode(tur);
+Key.Size = sizeof(double);
+Found = CacheFind(&Key, &hz);
+if(Found == 1) {
+	ctx->hInfo[idx].hzValue = hz;
+	}
+
+pthread_mutex_lock(&CacheLock);
+ctx->sweep.CacheHits += Found;
+ctx->sweep.CacheMisses += 1 - Found;
+pthread_mutex_unlock(&CacheLock);
+return(Found);
+}
+
+
+int CachePutPoint(struct TURCTX *ctx, struct TURING tur, int idx)
+{
+struct TURCACHERECORD	Key;
+
+if(fpCache == NULL) {
+	return(0);
+	}
+memset(&Key, 0, sizeof(Key));
+Key.n = mpfr_get_uj (ctx->gList[idx == 0 ? 0 : (idx - 1) / ctx->CountZ].n, MPFR_RNDN);
+Key.Kind = idx == 0 ? TURCACHE_BEFORE : TURCACHE_POINT;
+Key.Bits = (uint32_t) tur.DefaultBits;
+Key.CountZ = idx == 0 ? (uint32_t) ctx->CountZ : 0;
+Key.Mode = CacheMode(tur);
+Key.Size = sizeof(double);
+return(CacheAdd(&Key, &ctx->hInfo[idx].hzValue));
+}
+
+
+// *******************************************************************
+// At the end of the run, we report the cache hits and misses.
+// *******************************************************************
+int CacheReport(struct TURCTX *ctx, struct TURING tur)
+{
+fprintf(ctx->fpOut, "Cache (%s): Gram points %ju found, %ju computed; Hardy Z (intervals and single samples) %ju found, %ju computed \n",
+	tur.CacheFile, (uintmax_t) ctx->sweep.CacheGramHits, (uintmax_t) ctx->sweep.CacheGramMisses,
+	(uintmax_t) ctx->sweep.CacheHits, (uintmax_t) ctx->sweep.CacheMisses);
+return(1);
+}
+
+
+// *******************************************************************
+// We find the record with the given key (Key.Size must match too),
+// and copy its data to pData.  We return 1 if found.
+// *******************************************************************
+static int CacheFind(struct TURCACHERECORD *pKey, void *pData)
+{
+struct CACHESLOT *	p;
+size_t				k;
+int					Found = 0;
+
+pthread_mutex_lock(&CacheLock);
+if(Slot != NULL) {
+	k = (size_t) ((pKey->n * 0x9E3779B97F4A7C15ULL) ^ (pKey->Kind * 0x85EBCA6BU)) & (SlotCount - 1);
+	for(; Slot[k].Data != 0; k = (k + 1) & (SlotCount - 1)) {
+		p = &Slot[k];
+		if(p->Key.n == pKey->n && p->Key.Kind == pKey->Kind && p->Key.Bits == pKey->Bits
+			&& p->Key.CountZ == pKey->CountZ && p->Key.Mode == pKey->Mode
+			&& (pKey->Size == 0 || p->Key.Size == pKey->Size)) {
+			Found = CacheRead(p->Data, pData, p->Key.Size);
+			break;
+			}
+		}
+	}
+pthread_mutex_unlock(&CacheLock);
+return(Found);
+}
+
+
+// *******************************************************************
+// We append a record (pKey, then pKey->Size bytes of data) to the
+// file, and index it.  A key already present is not added again.  The
+// end of the file is found under the file lock, as another run may
+// have appended to it since.
+// *******************************************************************
+static int CacheAdd(struct TURCACHERECORD *pKey, const void *pData)
+{
+struct TURCACHERECORD	Rec;
+off_t					End = 0;
+bool					Ok = false;
+
+Rec = *pKey;
+Rec.Check = CacheCheck(&Rec, pData);
+pthread_mutex_lock(&CacheLock);
+if(fpCache != NULL && CacheFileLock(true) == 1) {
+	Ok = fseeko(fpCache, 0, SEEK_END) == 0 && (End = ftello(fpCache)) > 0
+		&& fwrite(&Rec, sizeof(Rec), 1, fpCache) == 1
+		&& fwrite(pData, Rec.Size, 1, fpCache) == 1 && fflush(fpCache) == 0;
+	CacheFileLock(false);
+	}
+if(Ok == true) {
+	CacheIndex(&Rec, (uint64_t) End + sizeof(Rec));
+	}
+pthread_mutex_unlock(&CacheLock);
+return(Ok == true ? 1 : 0);
+}
+
+
+// *******************************************************************
+// We add a record to the index (growing it at half full), unless its
+// key is already there.  The caller holds CacheLock (or is CacheOpen).
+// *******************************************************************
+static int CacheIndex(struct TURCACHERECORD *pKey, uint64_t Data)
+{
+struct CACHESLOT *	Old;
+size_t				i, k, OldCount;
+
+if(2 * (SlotUsed + 1) > SlotCount) {
+	Old = Slot;
+	OldCount = SlotCount;
+	if((Slot = calloc(2 * OldCount, sizeof(struct CACHESLOT))) == NULL) {
+		Slot = Old;
+		return(0);
+		}
+	SlotCount = 2 * OldCount;
+	SlotUsed = 0;
+	for(i=0; i < OldCount; i++) {
+		if(Old[i].Data != 0) {
+			CacheIndex(&Old[i].Key, Old[i].Data);
+			}
+		}
+	free(Old);
+	}
+
+k = (size_t) ((pKey->n * 0x9E3779B97F4A7C15ULL) ^ (pKey->Kind * 0x85EBCA6BU)) & (SlotCount - 1);
+for(; Slot[k].Data != 0; k = (k + 1) & (SlotCount - 1)) {
+	if(memcmp(&Slot[k].Key, pKey, offsetof(struct TURCACHERECORD, Size)) == 0) {
+		return(1);
+		}
+	}
+Slot[k].Key = *pKey;
+Slot[k].Data = Data;
+SlotUsed++;
+return(1);
+}
+
+
+// *******************************************************************
+// We read Size bytes at Offset: from the map if they are in it (as
+// they are for every record the file held when opened), and from the
+// file if not.  The caller holds CacheLock (or is CacheOpen).
+// *******************************************************************
+static int CacheRead(uint64_t Offset, void *pData, size_t Size)
+{
+if(pMap != NULL && Offset + Size <= MapSize) {
+	memcpy(pData, pMap + Offset, Size);
+	return(1);
+	}
+if(fseeko(fpCache, (off_t) Offset, SEEK_SET) != 0 || (Size > 0 && fread(pData, Size, 1, fpCache) != 1)) {
+	return(0);
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// The record checksum: FNV-1a over the record (with Check as 0) and
+// its data.
+// *******************************************************************
+static uint32_t CacheCheck(struct TURCACHERECORD *pRec, const void *pData)
+{
+struct TURCACHERECORD	Rec;
+const unsigned char *	p;
+uint32_t				Hash = 2166136261U;
+size_t					i;
+
+Rec = *pRec;
+Rec.Check = 0;
+p = (const unsigned char *) &Rec;
+for(i=0; i < sizeof(Rec); i++) {
+	Hash = (Hash ^ p[i]) * 16777619U;
+	}
+p = (const unsigned char *) pData;
+for(i=0; i < pRec->Size; i++) {
+	Hash = (Hash ^ p[i]) * 16777619U;
+	}
+return(Hash);
+}
+
+
+// *******************************************************************
+// The Hardy Z values differ (slightly) with -m and -E, so each is
+// cached apart from the others.
+// *******************************************************************
+static uint32_t CacheMode(struct TURING tur)
+{
+return(tur.Grid == true ? TURCACHE_GRID : tur.Mixed == true ? TURCACHE_MIXED : TURCACHE_MPFR);
+}
+
+
+// *******************************************************************
+// We lock (or unlock) the cache file against the other runs using it.
+// The lock is advisory, and taken only by turing.  On Windows there is
+// no lock, so a cache file must not be shared by runs at once there.
+// *******************************************************************
+static int CacheFileLock(bool Lock)
+{
+#ifdef _WIN32
+(void) Lock;
+return(1);
+#else
+while(flock(fileno(fpCache), Lock == true ? LOCK_EX : LOCK_UN) != 0) {
+	if(errno != EINTR) {
+		return(0);
+		}
+	}
+return(1);
+#endif
+}
@@ -0,0 +1,401 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <mpfr.h>
+#ifdef _WIN32
+#include <io.h>
+#endif
+
+#include "hgt.h"
+#include "turing.h"
+
+
+volatile sig_atomic_t		StopRequested = 0;
+
+static void		CkptSignal(int Signal);
+static int		CkptIntervals(struct TURCTX *ctx, struct TURING tur);
+static int		CkptReadIntervals(struct TURCTX *ctx, struct TURING tur);
+static int		CkptHardy(FILE *fp, const char *Key, struct HARDYINFO *pInfo);
+static int		CkptReadHardy(char *sLine, struct HARDYINFO *pInfo);
+
+
+// *******************************************************************
+// With -C, SIGINT and SIGTERM no longer kill us outright.  Instead, we
+// stop at the next Gram interval boundary, report and checkpoint the
+// intervals completed so far, and exit.
+// *******************************************************************
+int CkptSignals(void)
+{
+signal(SIGINT, CkptSignal);
+signal(SIGTERM, CkptSignal);
+return(1);
+}
+
+
+static void CkptSignal(int Signal)
+{
+StopRequested = 1;
+signal(Signal, CkptSignal);
+}
+
+
+// *******************************************************************
+// We write the checkpoint at the end of a window (whose size is
+// tur.CountGram), before CarryWindow.  First, the results of each of
+// the window's Gram intervals are appended to the interval file (see
+// CkptIntervals).  The checkpoint itself holds: (1) the command line
+// values that must match on resume, (2) the sweep totals that are not
+// per-interval results, and (3) exactly what CarryWindow would carry
+// into the next window.
+//
+// MPFR values are written in hex ("%Ra") and doubles with "%a", so
+// nothing is lost in the round trip.  We write to a temporary file
+// and rename it over the old checkpoint, so a checkpoint on disk is
+// always complete.
+// *******************************************************************
+int WriteCheckpoint(struct TURCTX *ctx, struct TURING tur)
+{
+char	sTemp[TUR_PATH_MAX + 8];
+FILE	*fp;
+mpfr_t	tNext;
+int		Last;
+
+Last = tur.CountGram;
+if(CkptIntervals(ctx, tur) == 0) {
+	return(0);
+	}
+snprintf(sTemp, sizeof(sTemp), "%s.tmp", tur.CkptFile);
+if((fp = fopen(sTemp, "w")) == NULL) {
+	fprintf(stderr, "Unable to write checkpoint file %s \n", sTemp);
+	return(0);
+	}
+
+fprintf(fp, "%s\n", TUR_CKPT_MAGIC);
+fprintf(fp, "t %s\n", tur.tBuf);
+fprintf(fp, "T %s\n", tur.TBuf[0] == '\0' ? "-" : tur.TBuf);
+fprintf(fp, "g %d\nc %d\nb %d\n", tur.WindowMax, tur.CountZ, tur.DefaultBits);
+fprintf(fp, "Total %ju\nDone %ju\nWindow %ju\n", (uintmax_t) ctx->sweep.Total,
+	(uintmax_t) ctx->sweep.Done, (uintmax_t) ctx->sweep.Window);
+fprintf(fp, "Sums %ju %ju %ju %ju %ju\n",
+	(uintmax_t) ctx->sweep.RefineSegments, (uintmax_t) ctx->sweep.RefineZeros,
+	(uintmax_t) ctx->sweep.RefineEvals, (uintmax_t) ctx->sweep.MixedSamples,
+	(uintmax_t) ctx->sweep.MixedEscalated);
+fprintf(fp, "Rosser %d %d %ju %ju %d %d %d\n", ctx->sweep.RosserK, ctx->sweep.RosserRun,
+	(uintmax_t) ctx->sweep.RosserBlocks, (uintmax_t) ctx->sweep.RosserFailed, 
+	ctx->sweep.BlockOpen ? 1 : 0, ctx->sweep.BlockLen, ctx->sweep.BlockZeros);
+fprintf(fp, "Class %ju %ju %ju %ju\n", (uintmax_t) ctx->sweep.ClassSettled,
+	(uintmax_t) ctx->sweep.ClassGram, (uintmax_t) ctx->sweep.ClassEscalated,
+	(uintmax_t) ctx->sweep.ClassSamples);
+fprintf(fp, "Zero %ju %ju\n", (uintmax_t) ctx->sweep.ZeroLocated, (uintmax_t) ctx->sweep.ZeroEvals);
+fprintf(fp, "Grid %a\n", ctx->sweep.GridBound);
+
+// -------------------------------------------------------------------
+// What CarryWindow would carry (see there).
+// -------------------------------------------------------------------
+mpfr_inits2 (mpfr_get_prec (ctx->tBefore), tNext, (mpfr_ptr) 0);
+mpfr_mul_si (tNext, ctx->gList[Last-1].lenSubInterval, ctx->CountZ - 1, MPFR_RNDN);
+mpfr_add (tNext, ctx->gList[Last-1].Gram, tNext, MPFR_RNDN);
+mpfr_fprintf(fp, "n %.0Rf\n", ctx->gList[Last].n);
+mpfr_fprintf(fp, "Gram %Ra\n", ctx->gList[Last].Gram);
+fprintf(fp, "Parity %d\nGood %d\n", ctx->gList[Last].MinusOneToN, ctx->gList[Last].Good ? 1 : 0);
+mpfr_fprintf(fp, "tBefore %Ra\n", tNext);
+CkptHardy(fp, "Z0", &ctx->hInfo[Last * ctx->CountZ]);
+CkptHardy(fp, "Z1", &ctx->hInfo[(Last * ctx->CountZ) + 1]);
+mpfr_clears (tNext, (mpfr_ptr) 0);
+
+fprintf(fp, "End\n");
+
+fflush(fp);
+#ifdef _WIN32
+_commit(_fileno(fp));
+#else
+fsync(fileno(fp));
+#endif
+fclose(fp);
+
+if(rename(sTemp, tur.CkptFile) != 0) {
+	remove(tur.CkptFile);			// Windows will not rename over a file
+	if(rename(sTemp, tur.CkptFile) != 0) {
+		fprintf(stderr, "Unable to replace checkpoint file %s \n", tur.CkptFile);
+		return(0);
+		}
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// With -r, we read the checkpoint and restore the sweep totals and
+// the carried Gram point and Hardy Z samples, just as if CarryWindow
+// had run, and rebuild the per-interval totals from the interval file.
+// On return, nOfGram is the 'n' of the next window's gList[1].  We
+// return 0 (after printing why) if the checkpoint is missing, damaged,
+// or was made with different command line values.
+// *******************************************************************
+int ReadCheckpoint(struct TURCTX *ctx, struct TURING tur, mpfr_t nOfGram)
+{
+FILE		*fp;
+char		sLine[TUR_CKPT_LINE_MAX];
+char		sValue[TUR_CKPT_LINE_MAX];
+int			Bits = 0, WindowMax = 0, Count = 0, Good = 0, Found = 0, Open = 0;
+uintmax_t	Total = 0, Sums[5];
+double		Bound;
+bool		Ok = true;
+
+if((fp = fopen(tur.CkptFile, "r")) == NULL) {
+	printf("Unable to open checkpoint file %s \n", tur.CkptFile);
+	return(0);
+	}
+if(fgets(sLine, sizeof(sLine), fp) == NULL
+	|| strncmp(sLine, TUR_CKPT_MAGIC, strlen(TUR_CKPT_MAGIC)) != 0) {
+	printf("The file %s is not a Turing checkpoint \n", tur.CkptFile);
+	fclose(fp);
+	return(0);
+	}
+
+while(Ok == true && fgets(sLine, sizeof(sLine), fp) != NULL) {
+	sValue[0] = '\0';
+	if(strncmp(sLine, "t ", 2) == 0) {
+		sscanf(sLine + 2, "%s", sValue);
+		Ok = strcmp(sValue, tur.tBuf) == 0;
+		}
+	else if(strncmp(sLine, "T ", 2) == 0) {
+		sscanf(sLine + 2, "%s", sValue);
+		Ok = strcmp(sValue, tur.TBuf[0] == '\0' ? "-" : tur.TBuf) == 0;
+		}
+	else if(sscanf(sLine, "g %d", &WindowMax) == 1) {
+		Ok = WindowMax == tur.WindowMax;
+		}
+	else if(sscanf(sLine, "c %d", &Count) == 1) {
+		Ok = Count == tur.CountZ;
+		}
+	else if(sscanf(sLine, "b %d", &Bits) == 1) {
+		Ok = Bits == tur.DefaultBits;
+		}
+	else if(sscanf(sLine, "Total %ju", &Total) == 1) {
+		Ok = (uint64_t) Total == ctx->sweep.Total;
+		}
+	else if(sscanf(sLine, "Done %ju", &Total) == 1) {
+		ctx->sweep.Done = (uint64_t) Total;
+		}
+	else if(sscanf(sLine, "Window %ju", &Total) == 1) {
+		ctx->sweep.Window = (uint64_t) Total;
+		}
+	else if(sscanf(sLine, "Sums %ju %ju %ju %ju %ju", &Sums[0], &Sums[1],
+		&Sums[2], &Sums[3], &Sums[4]) == 5) {
+		ctx->sweep.RefineSegments	= Sums[0];
+		ctx->sweep.RefineZeros		= Sums[1];
+		ctx->sweep.RefineEvals		= Sums[2];
+		ctx->sweep.MixedSamples		= Sums[3];
+		ctx->sweep.MixedEscalated	= Sums[4];
+		}
+	else if(sscanf(sLine, "Rosser %d %d %ju %ju %d %d %d", &ctx->sweep.RosserK, &ctx->sweep.RosserRun,
+		&Sums[0], &Sums[1], &Open, &ctx->sweep.BlockLen, &ctx->sweep.BlockZeros) == 7) {
+		ctx->sweep.RosserBlocks	= Sums[0];
+		ctx->sweep.RosserFailed	= Sums[1];
+		ctx->sweep.BlockOpen		= Open == 1 ? true : false;
+		ctx->sweep.RosserDone	= ctx->sweep.RosserK > 0 && ctx->sweep.RosserRun >= ctx->sweep.RosserK;
+		}
+	else if(sscanf(sLine, "Class %ju %ju %ju %ju", &Sums[0], &Sums[1], &Sums[2], &Sums[3]) == 4) {
+		ctx->sweep.ClassSettled		= Sums[0];
+		ctx->sweep.ClassGram		= Sums[1];
+		ctx->sweep.ClassEscalated	= Sums[2];
+		ctx->sweep.ClassSamples		= Sums[3];
+		}
+	else if(sscanf(sLine, "Zero %ju %ju", &Sums[0], &Sums[1]) == 2) {
+		ctx->sweep.ZeroLocated		= Sums[0];
+		ctx->sweep.ZeroEvals		= Sums[1];
+		}
+	else if(sscanf(sLine, "Grid %la", &Bound) == 1) {
+		ctx->sweep.GridBound		= Bound;
+		}
+	else if(sscanf(sLine, "n %s", sValue) == 1) {
+		Ok = mpfr_set_str (ctx->gList[0].n, sValue, 10, MPFR_RNDN) == 0;
+		Found++;
+		}
+	else if(sscanf(sLine, "Gram %s", sValue) == 1) {
+		Ok = mpfr_set_str (ctx->gList[0].Gram, sValue, 0, MPFR_RNDN) == 0;
+		Found++;
+		}
+	else if(sscanf(sLine, "Parity %d", &ctx->gList[0].MinusOneToN) == 1) {
+		Found++;
+		}
+	else if(sscanf(sLine, "Good %d", &Good) == 1) {
+		ctx->gList[0].Good = Good == 1 ? true : false;
+		Found++;
+		}
+	else if(sscanf(sLine, "tBefore %s", sValue) == 1) {
+		Ok = mpfr_set_str (ctx->tBefore, sValue, 0, MPFR_RNDN) == 0;
+		Found++;
+		}
+	else if(strncmp(sLine, "Z0 ", 3) == 0) {
+		Ok = CkptReadHardy(sLine + 3, &ctx->hInfo[0]) == 1;
+		Found++;
+		}
+	else if(strncmp(sLine, "Z1 ", 3) == 0) {
+		Ok = CkptReadHardy(sLine + 3, &ctx->hInfo[1]) == 1;
+		Found++;
+		}
+	}
+fclose(fp);
+
+if(Ok == false || Found != 7) {
+	printf("The checkpoint file %s does not match this command line (or is damaged) \n",
+		tur.CkptFile);
+	return(0);
+	}
+if(CkptReadIntervals(ctx, tur) == 0) {
+	return(0);
+	}
+
+mpfr_add_ui (nOfGram, ctx->gList[0].n, 1, MPFR_RNDN);
+mpfr_fprintf(stderr, "Resuming after Gram interval %ju of %ju (n = %.0Rf)\n\n",
+	(uintmax_t) ctx->sweep.Done, (uintmax_t) ctx->sweep.Total, ctx->gList[0].n);
+return(1);
+}
+
+
+// *******************************************************************
+// The interval file (the checkpoint's name with ".intervals" added)
+// has one line per Gram interval of the sweep completed so far:
+//
+//   Interval <index in the sweep> <n> <Zeros Found> <Gram good>
+//            <odd zeros expected> <possible Lehmer points>
+//
+// The lines of each window are appended (and synced) before its
+// checkpoint is written, so the file always holds at least the
+// intervals the checkpoint says are done.  It starts afresh with the
+// first window of a sweep.
+// *******************************************************************
+static int CkptIntervals(struct TURCTX *ctx, struct TURING tur)
+{
+char		sFile[TUR_PATH_MAX + 16];
+FILE		*fp;
+uint64_t	First;
+int			i, j, Lehmer;
+
+First = ctx->sweep.Done - (uint64_t) tur.CountGram;
+snprintf(sFile, sizeof(sFile), "%s.intervals", tur.CkptFile);
+if((fp = fopen(sFile, First == 0 ? "w" : "a")) == NULL) {
+	fprintf(stderr, "Unable to write checkpoint interval file %s \n", sFile);
+	return(0);
+	}
+for(i=0; i < tur.CountGram; i++) {
+	Lehmer = 0;
+	for(j = 0; j < ctx->CountZ; j++) {
+		Lehmer += ctx->hInfo[(i * ctx->CountZ) + 2 + j].Lehmer == true ? 1 : 0;
+		}
+	mpfr_fprintf(fp, "Interval %ju %.0Rf %d %d %d %d\n", (uintmax_t) (First + i), ctx->gList[i].n,
+		ctx->gList[i].ZerosFound, ctx->gList[i].Good ? 1 : 0, ctx->gList[i].OddZeros ? 1 : 0, Lehmer);
+	}
+fflush(fp);
+#ifdef _WIN32
+_commit(_fileno(fp));
+#else
+fsync(fileno(fp));
+#endif
+fclose(fp);
+return(1);
+}
+
+
+// *******************************************************************
+// On resume, we rebuild the sweep's per-interval totals from the
+// first sweep.Done lines of the interval file (each must be the next
+// interval in turn), and cut off any lines after them (appended for a
+// window whose checkpoint was never written).  The last Gram point of
+// a finished sweep is counted as SweepTally counts it.
+// *******************************************************************
+static int CkptReadIntervals(struct TURCTX *ctx, struct TURING tur)
+{
+char		sFile[TUR_PATH_MAX + 16];
+char		sLine[TUR_CKPT_LINE_MAX];
+FILE		*fp;
+uintmax_t	Index;
+uint64_t	Count = 0;
+long		End = 0;
+int			Zeros, Good, Odd, Lehmer;
+
+snprintf(sFile, sizeof(sFile), "%s.intervals", tur.CkptFile);
+if((fp = fopen(sFile, "r+")) == NULL) {
+	printf("Unable to open checkpoint interval file %s \n", sFile);
+	return(0);
+	}
+ctx->sweep.ZerosFound = ctx->sweep.BadGram = ctx->sweep.BadParity = ctx->sweep.Lehmer = 0;
+while(Count < ctx->sweep.Done && fgets(sLine, sizeof(sLine), fp) != NULL) {
+	if(sscanf(sLine, "Interval %ju %*s %d %d %d %d", &Index, &Zeros, &Good, &Odd, &Lehmer) != 5
+		|| (uint64_t) Index != Count) {
+		break;
+		}
+	ctx->sweep.ZerosFound += (uint64_t) Zeros;
+	ctx->sweep.BadGram += Good == 1 ? 0 : 1;
+	ctx->sweep.BadParity += (Zeros % 2 == 0) == (Odd == 1) ? 1 : 0;
+	ctx->sweep.Lehmer += (uint64_t) Lehmer;
+	Count++;
+	End = ftell(fp);
+	}
+if(Count != ctx->sweep.Done) {
+	printf("The checkpoint interval file %s holds %ju of the %ju intervals done (or is damaged) \n",
+		sFile, (uintmax_t) Count, (uintmax_t) ctx->sweep.Done);
+	fclose(fp);
+	return(0);
+	}
+if((ctx->sweep.Done == ctx->sweep.Total || ctx->sweep.RosserDone == true)
+	&& ctx->gList[0].Good == false) {
+	ctx->sweep.BadGram += 1;
+	}
+
+fflush(fp);
+#ifdef _WIN32
+_chsize_s(_fileno(fp), (__int64) End);
+#else
+if(ftruncate(fileno(fp), (off_t) End) != 0) {
+	fprintf(stderr, "Unable to cut back checkpoint interval file %s \n", sFile);
+	}
+#endif
+fclose(fp);
+return(1);
+}
+
+
+// *******************************************************************
+// We write (and read back) one HARDYINFO sample on a single line.
+// *******************************************************************
+static int CkptHardy(FILE *fp, const char *Key, struct HARDYINFO *pInfo)
+{
+fprintf(fp, "%s %a %a %d %d %d\n", Key, pInfo->hzValue, pInfo->hzRise,
+	pInfo->ZeroCross ? 1 : 0, pInfo->TowardZero ? 1 : 0, pInfo->Lehmer ? 1 : 0);
+return(1);
+}
+
+
+static int CkptReadHardy(char *sLine, struct HARDYINFO *pInfo)
+{
+char	sValue[2][TUR_CKPT_LINE_MAX];
+int		Flags[3];
+
+if(sscanf(sLine, "%s %s %d %d %d", sValue[0], sValue[1], &Flags[0], &Flags[1],
+	&Flags[2]) != 5) {
+	return(0);
+	}
+memset(pInfo, 0, sizeof(struct HARDYINFO));
+pInfo->hzValue		= strtod(sValue[0], NULL);
+pInfo->hzRise		= strtod(sValue[1], NULL);
+pInfo->ZeroCross	= Flags[0] == 1 ? true : false;
+pInfo->TowardZero	= Flags[1] == 1 ? true : false;
+pInfo->Lehmer		= Flags[2] == 1 ? true : false;
+return(1);
+}
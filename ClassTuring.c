@@ -0,0 +1,156 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <signal.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+
+extern struct	HGT_INIT	hgt_init;
+extern volatile sig_atomic_t	StopRequested;
+
+static int		ClassSamples(struct TURCTX *ctx, struct TURING tur, int idx, int Count);
+
+
+// *******************************************************************
+// With -q (classification), we first find only the sign of Hardy Z
+// at each Gram point of the window, each by the double precision
+// Riemann-Siegel formula with its error bound (see HardyZDouble), and
+// with MPFR only when that bound cannot certify the sign.  That tells
+// us which Gram points are good.
+//
+// A Gram interval whose two Gram points are both good is settled:
+// (-1)^n Z(g(n)) and (-1)^(n+1) Z(g(n+1)) are both positive, so Z
+// changes sign, and the interval holds an odd number of zeros (we
+// count the one Gram's law guarantees).  We skip its sub-intervals.
+// Only the intervals that touch a bad Gram point -- the Gram blocks
+// of length two or more, where the zeros may not follow Gram's law --
+// are then sampled in full.
+//
+// We also compute the sample before the first Gram point (first
+// window only) and the sample before the last Gram point, which
+// CarryWindow takes into the next window.  As with HardyZWindow, we
+// return the number of Gram intervals completed.
+// *******************************************************************
+int ClassHardyZWindow(struct TURCTX *ctx, struct TURING tur)
+{
+int		i, j, Last;
+
+if(ctx->sweep.Window == 0) {
+	mpfr_sub (ctx->tBefore, ctx->gList[0].Gram, ctx->gList[0].lenSubInterval, MPFR_RNDN);
+	ClassSamples(ctx, tur, 0, 1);
+	}
+for(i = ctx->sweep.Window == 0 ? 0 : 1; i <= tur.CountGram; i++) {
+	ctx->sweep.ClassEscalated += MixedHardyZ(ctx, tur, (i * ctx->CountZ) + 1);
+	ctx->sweep.ClassGram += 1;
+	}
+for(i=0; i <= tur.CountGram; i++) {
+	ctx->gList[i].Good = ctx->gList[i].MinusOneToN * ctx->hInfo[(i * ctx->CountZ) + 1].hzValue
+		> 0 ? true : false;
+	}
+
+// -------------------------------------------------------------------
+// Now sample the intervals that are not settled.
+// -------------------------------------------------------------------
+fprintf(stderr, "Processing Gram interval: ");
+for(i=0; i < tur.CountGram && StopRequested == 0; i++) {
+	ctx->gList[i].Settled = ctx->gList[i].Good == true && ctx->gList[i+1].Good == true;
+	if(ctx->gList[i].Settled == true) {
+		for(j = 2; j <= ctx->CountZ; j++) {
+			ctx->hInfo[(i * ctx->CountZ) + j].hzValue = NAN;
+			}
+		ctx->sweep.ClassSettled += 1;
+		TextInterval(ctx, tur, i);
+		continue;
+		}
+	ClassSamples(ctx, tur, (i * ctx->CountZ) + 2, ctx->CountZ - 1);
+	TextInterval(ctx, tur, i);
+	fprintf(stderr, "%d..", i);
+	}
+fprintf(stderr, "\n\n");
+
+Last = i;
+if(Last > 0 && ctx->gList[Last-1].Settled == true) {
+	ClassSamples(ctx, tur, Last * ctx->CountZ, 1);
+	}
+return(Last);
+}
+
+
+// *******************************************************************
+// AnalyzeWindow calls this for each settled Gram interval, once the
+// zero crossings are found, and before the Lehmer test.  The interval
+// holds the one zero that Gram's law guarantees, which we put at its
+// closing Gram point.  Since Z has changed sign by then, that Gram
+// point is moving away from zero.  The samples in between were not
+// computed, so they get no flags.
+// *******************************************************************
+int ClassAnalyze(struct TURCTX *ctx, int i)
+{
+int		j, idx;
+
+idx = (i * ctx->CountZ) + 1;
+for(j = 1; j < ctx->CountZ; j++) {
+	ctx->hInfo[idx + j].hzRise = 0;
+	ctx->hInfo[idx + j].TowardZero = true;
+	ctx->hInfo[idx + j].ZeroCross = false;
+	}
+idx += ctx->CountZ;
+ctx->hInfo[idx].hzRise = ctx->hInfo[idx].hzValue - ctx->hInfo[idx - ctx->CountZ].hzValue;
+ctx->hInfo[idx].TowardZero = false;
+ctx->hInfo[idx].ZeroCross = true;
+ctx->gList[i].ZerosFound = 1;
+return(1);
+}
+
+
+// *******************************************************************
+// We compute Count Hardy Z samples in full (the usual way, or as -m
+// does), starting with hInfo index idx (see HardyT).
+// *******************************************************************
+static int ClassSamples(struct TURCTX *ctx, struct TURING tur, int idx, int Count)
+{
+mpfr_t	t, Incr;
+int		k;
+
+ctx->sweep.ClassSamples += Count;
+if(tur.Mixed == true) {
+	for(k = 0; k < Count; k++) {
+		ctx->sweep.MixedEscalated += MixedHardyZ(ctx, tur, idx + k);
+		}
+	ctx->sweep.MixedSamples += Count;
+	return(1);
+	}
+mpfr_inits2 (hgt_init.DefaultBits, t, Incr, (mpfr_ptr) 0);
+HardyT(ctx, t, tur, idx);
+mpfr_set (Incr, ctx->gList[idx > 0 ? (idx - 1) / ctx->CountZ : 0].lenSubInterval, MPFR_RNDN);
+TimedHardyZ(t, Incr, Count, TUR_CALLER(ctx, idx), HardyZCallbackC);
+mpfr_clears (t, Incr, (mpfr_ptr) 0);
+return(1);
+}
+
+
+// *******************************************************************
+// At the end of the run, we report how much -q saved.
+// *******************************************************************
+int ClassReport(struct TURCTX *ctx)
+{
+fprintf(ctx->fpOut, "Classification: %ju of %ju Gram intervals settled by Gram's law (not sampled) \n",
+	(uintmax_t) ctx->sweep.ClassSettled, (uintmax_t) ctx->sweep.Done);
+fprintf(ctx->fpOut, "Gram point signs = %ju (%ju needed MPFR), other Hardy Z values = %ju \n",
+	(uintmax_t) ctx->sweep.ClassGram, (uintmax_t) ctx->sweep.ClassEscalated,
+	(uintmax_t) ctx->sweep.ClassSamples);
+return(1);
+}
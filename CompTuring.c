@@ -11,6 +11,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include <ctype.h>
+#include <signal.h>
 #include <pthread.h>
 #include <mpfr.h>
 
@@ -19,54 +20,401 @@
 
 extern struct	HGT_INIT	hgt_init;
 
-int    CountZ;   	// number of Z(t) per Gram interval (excluding right endpoint)
-struct GRAMLIST		gList[HGT_TUR_GRAM_PTS_MAX + 1];
-struct HARDYINFO	hInfo[(HGT_TUR_GRAM_PTS_MAX * HGT_TUR_SUBINTVL_MAX) + 2];
+extern volatile sig_atomic_t	StopRequested;
+
+static struct TURCTX *	CtxTable[TUR_CTX_MAX];	// see TUR_CALLER
+static pthread_mutex_t	CtxLock = PTHREAD_MUTEX_INITIALIZER;
 
 // *******************************************************************
-// We 
+// We compute the Turing Method data for the requested Gram intervals.
 // *******************************************************************
 int ComputeTuring(struct TURING tur)
 {
-mpfr_t				t, nOfGram, Accuracy, HardyZ, Temp1, Temp2;
-int					i, j, hzNum;
-int					MinusOneToN;
-uint64_t			ui64N;
+struct TURCTX *	ctx;
+int				Result = 0;
 
-// -------------------------------------------------------------------
-// Initialize the MPFR system and the variables that will hold the 
-// Hardy Z remainder coefficients.
-// -------------------------------------------------------------------
+TuringOpen(tur);
+if((ctx = TuringCtxNew(tur.CountGram, tur.CountZ)) != NULL) {
+	Result = TuringJob(ctx, tur);
+	TuringCtxFree(ctx);
+	}
+TuringClose();
+return(Result);
+}
+
+
+// *******************************************************************
+// We initialize the MPFR system and the Hardy Z remainder
+// coefficients.  These belong to libHGT, and so are shared by every
+// context in the process.  In batch mode (-f) this is done once, for
+// all the jobs.
+// *******************************************************************
+int TuringOpen(struct TURING tur)
+{
+StatsBegin(TUR_PHASE_SETUP);
 InitMPFR(tur.DefaultBits, tur.Threads, tur.DebugFlags, true);
 InitCoeffMPFR(hgt_init.DefaultBits);	
+if(tur.CacheFile[0] != '\0') {
+	CacheOpen(tur);
+	}
+if(tur.IndexFile[0] != '\0' && tur.IndexStride == 0) {
+	IndexOpen(tur);
+	}
+StatsEnd(TUR_PHASE_SETUP);
+return(1);
+}
+
 
+// *******************************************************************
+// We free everything TuringOpen initialized.
+// *******************************************************************
+int TuringClose(void)
+{
+StatsBegin(TUR_PHASE_SETUP);
+CacheClose();
+IndexClose();
+CloseCoeffMPFR();
+CloseMPFR();
+StatsEnd(TUR_PHASE_SETUP);
+return(1);
+}
 
-mpfr_inits2 (hgt_init.DefaultBits, t, nOfGram, Accuracy, HardyZ, Temp1, Temp2, (mpfr_ptr) 0);
-CountZ = tur.CountZ;	// at least for now, save globally for callbacks
+
+// *******************************************************************
+// We allocate a context for windows of up to MaxGram Gram intervals
+// of up to MaxCountZ samples each, and take a slot for it in the
+// context table.  We return NULL (after printing why) if we cannot.
+// *******************************************************************
+struct TURCTX * TuringCtxNew(int MaxGram, int MaxCountZ)
+{
+struct TURCTX *	ctx;
+int				i, hzNum;
+
+hzNum = (MaxGram * MaxCountZ) + 2;
+if((ctx = calloc(1, sizeof(struct TURCTX))) == NULL
+	|| (ctx->gList = calloc(MaxGram + 1, sizeof(struct GRAMLIST))) == NULL
+	|| (ctx->hInfo = calloc(hzNum, sizeof(struct HARDYINFO))) == NULL
+	|| (ctx->Refined = calloc(hzNum, sizeof(bool))) == NULL
+	|| (ctx->tText = malloc((size_t) hzNum * TUR_T_TEXT_MAX)) == NULL) {
+	fprintf(stderr, "Unable to allocate a Turing context \n");
+	if(ctx != NULL) {
+		free(ctx->gList);
+		free(ctx->hInfo);
+		free(ctx->Refined);
+		free(ctx->tText);
+		free(ctx);
+		}
+	return(NULL);
+	}
+
+pthread_mutex_lock(&CtxLock);
+for(ctx->Slot = 0; ctx->Slot < TUR_CTX_MAX && CtxTable[ctx->Slot] != NULL; ctx->Slot++)
+	;
+if(ctx->Slot < TUR_CTX_MAX) {
+	CtxTable[ctx->Slot] = ctx;
+	}
+pthread_mutex_unlock(&CtxLock);
+if(ctx->Slot == TUR_CTX_MAX) {
+	fprintf(stderr, "More than %d Turing contexts at once \n", TUR_CTX_MAX);
+	free(ctx->gList);
+	free(ctx->hInfo);
+	free(ctx->Refined);
+	free(ctx->tText);
+	free(ctx);
+	return(NULL);
+	}
 
 // -------------------------------------------------------------------
 // Do an MPFR initialization of the MPFR elemenrts in the GRAMLIST 
 // structure.  We go "one past" our Gram count for reasons stated below.
 // -------------------------------------------------------------------
-for(i=0; i <= tur.CountGram; i++) {
-	mpfr_inits2 (hgt_init.DefaultBits, gList[i].Gram, gList[i].n, 
-		gList[i].lenInterval, gList[i].lenSubInterval, (mpfr_ptr) 0);
+ctx->MaxGram = MaxGram;
+ctx->MaxCountZ = MaxCountZ;
+ctx->fpOut = stdout;
+mpfr_inits2 (hgt_init.DefaultBits, ctx->tBefore, (mpfr_ptr) 0);
+for(i=0; i <= MaxGram; i++) {
+	mpfr_inits2 (hgt_init.DefaultBits, ctx->gList[i].Gram, ctx->gList[i].n, 
+		ctx->gList[i].lenInterval, ctx->gList[i].lenSubInterval, (mpfr_ptr) 0);
 	}
+return(ctx);
+}
+
+
+// *******************************************************************
+// We free a context, and its slot in the context table.
+// *******************************************************************
+int TuringCtxFree(struct TURCTX *ctx)
+{
+int		i;
+
+mpfr_clears (ctx->tBefore, (mpfr_ptr) 0);
+for(i=0; i <= ctx->MaxGram; i++) {
+	mpfr_clears (ctx->gList[i].Gram, ctx->gList[i].lenInterval, ctx->gList[i].n, 
+	ctx->gList[i].lenSubInterval, (mpfr_ptr) 0);
+	}
+if(ctx->Zeros != NULL) {
+	for(i=0; i < (ctx->MaxGram * ctx->MaxCountZ) + 2; i++) {
+		mpfr_clear (ctx->Zeros[i].t);
+		}
+	free(ctx->Zeros);
+	}
+pthread_mutex_lock(&CtxLock);
+CtxTable[ctx->Slot] = NULL;
+pthread_mutex_unlock(&CtxLock);
+free(ctx->gList);
+free(ctx->hInfo);
+free(ctx->Refined);
+free(ctx->tText);
+free(ctx);
+return(1);
+}
+
+
+// *******************************************************************
+// The HardyZWithCount callbacks find their context from CallerID.
+// Other threads (the -D daemon's jobs, the -O writer) may register or
+// free contexts meanwhile, so we read the table under CtxLock (the
+// cost is nothing beside a Hardy Z evaluation).
+// *******************************************************************
+struct TURCTX * TuringCtxOf(int CallerID)
+{
+struct TURCTX *	ctx;
+
+pthread_mutex_lock(&CtxLock);
+ctx = CtxTable[CallerID >> TUR_CTX_SHIFT];
+pthread_mutex_unlock(&CtxLock);
+return(ctx);
+}
+
+
+// *******************************************************************
+// We compute one job: the Turing Method data for the Gram intervals
+// requested by tur, in the given context (after TuringOpen).
+//
+// The work is done in "windows" of at most tur.CountGram Gram 
+// intervals, so that our gList and hInfo arrays never need to be
+// larger than HGT_TUR_GRAM_PTS_MAX intervals.  Without the -T or -G 
+// command line parameters, there is exactly one window (the original
+// behavior).  With them, we sweep through the requested range one
+// window at a time, carrying the last Gram point and the last Hardy Z 
+// samples of each window into the next.
+// *******************************************************************
+int TuringJob(struct TURCTX *ctx, struct TURING tur)
+{
+mpfr_t				t, nOfGram, Accuracy, nEnd;
+int					Completed;
+bool				IsSweep, Stopped = false, StateOk = true;
+
+mpfr_inits2 (hgt_init.DefaultBits, t, nOfGram, Accuracy, nEnd, (mpfr_ptr) 0);
+if(tur.CountGram > ctx->MaxGram || tur.CountZ > ctx->MaxCountZ) {
+	fprintf(ctx->fpOut, "The context is too small for -g %d -c %d \n", tur.CountGram, tur.CountZ);
+	mpfr_clears (t, nOfGram, Accuracy, nEnd, (mpfr_ptr) 0);
+	return(0);
+	}
+ctx->CountZ = tur.CountZ;
+ctx->OutputDP = tur.OutputDP;
 
 // -------------------------------------------------------------------
 // Convert 't' from a string to MPFR.  Then locate the largest 'n' 
-// such that G(n) <= 't'.  As part of this, we set the accuracy
-// desired (for all code below) in locating Gram points.
+// such that G(n) <= 't' (or, with -n, take the 'n' we were given).
+// As part of this, we set the accuracy desired (for all code below)
+// in locating Gram points.
 // -------------------------------------------------------------------
 mpfr_set_str (t, tur.tBuf, 10, MPFR_RNDN);
 
-mpfr_set_str (Accuracy, "0.1", 10, MPFR_RNDN);
-mpfr_pow_ui(Accuracy, Accuracy, 16, MPFR_RNDN);
-mpfr_div_ui(Accuracy, Accuracy, 2, MPFR_RNDN);
+GramAccuracy(Accuracy);
+
+if(tur.StartN > 0) {
+	mpfr_set_uj (nOfGram, tur.StartN, MPFR_RNDN);
+	}
+else {
+	StatsBegin(TUR_PHASE_GRAMNEAR);
+	if(IndexNearT(&nOfGram, t) == 0) {
+		GramNearT(&nOfGram, t);
+		}
+	StatsEnd(TUR_PHASE_GRAMNEAR);
+	}
 
-GramNearT(&nOfGram, t);
-ui64N = mpfr_get_uj (nOfGram, MPFR_RNDN);
-MinusOneToN = (ui64N % 2 == 0) ? 1 : -1;
+// -------------------------------------------------------------------
+// Determine the total number of Gram intervals to process.  With -T,
+// we cover every Gram interval from the one containing 't' through 
+// the one containing 'T'.  With -G, the user gave us the count.
+// -------------------------------------------------------------------
+memset(&ctx->sweep, 0, sizeof(ctx->sweep));
+ctx->fpBin = NULL;
+ctx->BinFailed = false;
+ctx->sweep.Total = tur.SweepGram;
+if(tur.TBuf[0] != '\0') {
+	mpfr_set_str (t, tur.TBuf, 10, MPFR_RNDN);
+	StatsBegin(TUR_PHASE_GRAMNEAR);
+	if(IndexNearT(&nEnd, t) == 0) {
+		GramNearT(&nEnd, t);
+		}
+	StatsEnd(TUR_PHASE_GRAMNEAR);
+	ctx->sweep.Total = mpfr_get_uj (nEnd, MPFR_RNDN) - mpfr_get_uj (nOfGram, MPFR_RNDN) + 1;
+	}
+if(tur.Rosser == true && ctx->sweep.Total == 0) {
+	ctx->sweep.Total = TUR_ROSSER_GRAM_MAX;
+	}
+IsSweep = ctx->sweep.Total > 0 ? true : false;
+if(IsSweep == false) {
+	ctx->sweep.Total = tur.CountGram;
+	}
+
+// -------------------------------------------------------------------
+// With -C, we checkpoint at the end of each window, and a SIGINT or
+// SIGTERM stops us at the next Gram interval boundary.  With -r, we 
+// pick up where the checkpoint left off.
+// -------------------------------------------------------------------
+tur.WindowMax = tur.CountGram;
+if(tur.CkptFile[0] != '\0') {
+	CkptSignals();
+	}
+if(tur.Writer == true) {
+	WriterOpen(ctx);
+	}
+if(tur.Resume == true) {
+	StatsBegin(TUR_PHASE_OUTPUT);
+	StateOk = ReadCheckpoint(ctx, tur, nOfGram) == 1 ? true : false;
+	StatsEnd(TUR_PHASE_OUTPUT);
+	}
+
+// -------------------------------------------------------------------
+// Process the windows.  Within this loop, tur.CountGram is the number
+// of Gram intervals in the current window (only the last window of a
+// sweep, or a window cut short by a signal, can be short).
+// -------------------------------------------------------------------
+while(StateOk == true && Stopped == false && ctx->sweep.RosserDone == false
+	&& ctx->sweep.Done < ctx->sweep.Total) {
+	tur.CountGram = (ctx->sweep.Total - ctx->sweep.Done) < (uint64_t) tur.WindowMax 
+		? (int) (ctx->sweep.Total - ctx->sweep.Done) : tur.WindowMax;
+	StatsBegin(TUR_PHASE_GRAMPTS);
+	GramWindow(ctx, tur, nOfGram, Accuracy);
+	StatsEnd(TUR_PHASE_GRAMPTS);
+	if(tur.Rosser == true && ctx->sweep.RosserK == 0) {
+		ctx->sweep.RosserK = ComputeTuringK(ctx->gList[0].Gram);
+		}
+	StatsBegin(TUR_PHASE_HARDYZ);
+	Completed = HardyZWindow(ctx, tur);
+	StatsEnd(TUR_PHASE_HARDYZ);
+	if(tur.Mixed == true && tur.Classify == false) {
+		ctx->sweep.MixedSamples += ((uint64_t) Completed * ctx->CountZ) + (ctx->sweep.Window == 0 ? 2 : 1);
+		}
+	if(Completed < tur.CountGram) {
+		Stopped = ctx->sweep.RosserDone == true ? false : true;
+		if(Completed == 0) {
+			break;
+			}
+		tur.CountGram = Completed;
+		}
+	StatsBegin(TUR_PHASE_ANALYSIS);
+	AnalyzeWindow(ctx, tur);
+	StatsEnd(TUR_PHASE_ANALYSIS);
+	if(tur.Refine > 0) {
+		StatsBegin(TUR_PHASE_REFINE);
+		RefineWindow(ctx, tur);
+		StatsEnd(TUR_PHASE_REFINE);
+		}
+
+	if(IsSweep == true) {
+		fprintf(ctx->fpOut, "Sweep window %ju: Gram intervals %ju through %ju of %ju\n\n", 
+			(uintmax_t) ctx->sweep.Window, (uintmax_t) ctx->sweep.Done + 1, 
+			(uintmax_t) (ctx->sweep.Done + tur.CountGram), (uintmax_t) ctx->sweep.Total);
+		}
+	if(tur.ZeroDigits > 0) {
+		StatsBegin(TUR_PHASE_ZEROS);
+		ZeroWindow(ctx, tur);
+		StatsEnd(TUR_PHASE_ZEROS);
+		}
+	StatsBegin(TUR_PHASE_REPORT);
+	if(ctx->Writer == NULL || WriterReport(ctx, tur) == 0) {
+		TuringReport(ctx, tur);
+		if(tur.ZeroDigits > 0) {
+			ZeroReport(ctx, tur);
+			}
+		}
+	StatsEnd(TUR_PHASE_REPORT);
+	StatsBegin(TUR_PHASE_ANALYSIS);
+	SweepTally(ctx, tur);
+	StatsEnd(TUR_PHASE_ANALYSIS);
+	if(tur.BinFile[0] != '\0') {
+		StatsBegin(TUR_PHASE_OUTPUT);
+		BinWindow(ctx, tur);
+		StatsEnd(TUR_PHASE_OUTPUT);
+		}
+	if(IsSweep == true) {
+		fprintf(ctx->fpOut, "\n");
+		}
+	if(ctx->Writer != NULL) {
+		WriterPush(ctx, tur.CkptFile[0] != '\0');
+		}
+	ctx->sweep.Done += tur.CountGram;
+	ctx->sweep.Window++;
+	if(tur.CkptFile[0] != '\0') {
+		StatsBegin(TUR_PHASE_OUTPUT);
+		WriteCheckpoint(ctx, tur);
+		StatsEnd(TUR_PHASE_OUTPUT);
+		}
+	if(Stopped == false && ctx->sweep.RosserDone == false && ctx->sweep.Done < ctx->sweep.Total) {
+		CarryWindow(ctx, tur);
+		}
+	}
+if(Stopped == true) {
+	fprintf(stderr, "Stopped after Gram interval %ju of %ju.  Resume with -r -C %s\n",
+		(uintmax_t) ctx->sweep.Done, (uintmax_t) ctx->sweep.Total, tur.CkptFile);
+	}
+else if(IsSweep == true && StateOk == true) {
+	SweepReport(ctx);
+	}
+if(tur.Rosser == true && StateOk == true) {
+	RosserReport(ctx);
+	}
+if(tur.Classify == true) {
+	ClassReport(ctx);
+	}
+if(tur.ZeroDigits > 0) {
+	fprintf(ctx->fpOut, "Zero isolation: %ju zeros located to within 1e-%d, with %ju Hardy Z values \n",
+		(uintmax_t) ctx->sweep.ZeroLocated, tur.ZeroDigits, (uintmax_t) ctx->sweep.ZeroEvals);
+	}
+if(tur.Mixed == true) {
+	fprintf(ctx->fpOut, "Mixed precision: %ju of %ju Hardy Z values were re-computed with MPFR \n",
+		(uintmax_t) ctx->sweep.MixedEscalated, (uintmax_t) ctx->sweep.MixedSamples);
+	}
+if(tur.Grid == true && ctx->sweep.GridBound > 0) {
+	fprintf(ctx->fpOut, "Grid engine: largest error bound of a double precision Hardy Z value = %.3e \n",
+		ctx->sweep.GridBound);
+	}
+if(tur.CacheFile[0] != '\0') {
+	CacheReport(ctx, tur);
+	}
+if(tur.IndexFile[0] != '\0') {
+	IndexReport(ctx, tur);
+	}
+if(tur.Refine > 0) {
+	fprintf(ctx->fpOut, "Adaptive refinement: %ju sub-intervals re-sampled, %ju zero crossings found, %ju additional Hardy Z values \n",
+		(uintmax_t) ctx->sweep.RefineSegments, (uintmax_t) ctx->sweep.RefineZeros, 
+		(uintmax_t) ctx->sweep.RefineEvals);
+	}
+
+PoolClose(ctx);
+WriterClose(ctx);
+BinClose(ctx);
+mpfr_clears (t, nOfGram, Accuracy, nEnd, (mpfr_ptr) 0);
+return((Stopped == true || StateOk == false) ? 0 : 1);	
+}
+
+
+// *******************************************************************
+// We locate the Gram points of the current window.  In the first
+// window, we start with the 'n' found by GramNearT.  In later windows,
+// gList[0] was carried from the previous window and we start at 
+// gList[1].  On return, nOfGram is the 'n' of the first Gram point
+// of the NEXT window's gList[1].
+// *******************************************************************
+int GramWindow(struct TURCTX *ctx, struct TURING tur, mpfr_t nOfGram, mpfr_t Accuracy)
+{
+int			i, First;
+uint64_t	ui64N;
 
 // -------------------------------------------------------------------
 // In our GRAMLIST structure, we save the Count (plus 1) Gram 
@@ -74,13 +422,31 @@ MinusOneToN = (ui64N % 2 == 0) ? 1 : -1;
 // "plus 1" is because we also do this for the first 'n' AFTER our 
 // Count of Gram points -- this allows us to calculate the interval 
 // length of our last Gram point, and the Hardy Z value at that
-// next Gram point.
-// -------------------------------------------------------------------
-for(i=0; i <= tur.CountGram; i++) {
-	GramAtN(&gList[i].Gram, nOfGram, Accuracy);
-	mpfr_set (gList[i].n, nOfGram, MPFR_RNDN);
-	gList[i].MinusOneToN = MinusOneToN;
-	MinusOneToN *= -1;
+// next Gram point.  Only the very first Gram point is located from
+// scratch (by GramAtN, or from the nearest -I index entry); each
+// later one starts from its predecessor.
+// -------------------------------------------------------------------
+First = (ctx->sweep.Window == 0) ? 0 : 1;
+if(First == 0) {
+	ui64N = mpfr_get_uj (nOfGram, MPFR_RNDN);
+	ctx->gList[0].MinusOneToN = (ui64N % 2 == 0) ? 1 : -1;
+	}
+for(i=First; i <= tur.CountGram; i++) {
+	mpfr_set (ctx->gList[i].n, nOfGram, MPFR_RNDN);
+	if(CacheGram(ctx, tur, i) == 0) {
+		if(i == 0) {
+			if(IndexGram(ctx, &ctx->gList[i].Gram, nOfGram, Accuracy) == 0) {
+				GramAtN(&ctx->gList[i].Gram, nOfGram, Accuracy);
+				}
+			}
+		else {
+			GramNext(&ctx->gList[i].Gram, ctx->gList[i-1].Gram, nOfGram, Accuracy);
+			}
+		CachePutGram(ctx, tur, i);
+		}
+	if(i > 0) {
+		ctx->gList[i].MinusOneToN = -ctx->gList[i-1].MinusOneToN;
+		}
 	mpfr_add_ui (nOfGram, nOfGram, 1, MPFR_RNDN);
 	}
 
@@ -90,10 +456,61 @@ for(i=0; i <= tur.CountGram; i++) {
 // and sub-interval lengths.
 // -------------------------------------------------------------------
 for(i=0; i < tur.CountGram; i++) {
-	mpfr_sub (gList[i].lenInterval, gList[i+1].Gram, gList[i].Gram, MPFR_RNDN);
-	mpfr_div_si (gList[i].lenSubInterval, gList[i].lenInterval, tur.CountZ, MPFR_RNDN);
+	mpfr_sub (ctx->gList[i].lenInterval, ctx->gList[i+1].Gram, ctx->gList[i].Gram, MPFR_RNDN);
+	mpfr_div_si (ctx->gList[i].lenSubInterval, ctx->gList[i].lenInterval, tur.CountZ, MPFR_RNDN);
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// We compute the Hardy Z values for the current window.  We return 
+// the number of Gram intervals completed, which is less than
+// tur.CountGram only if we were asked to stop (see CkptTuring.c).  In
+// that case the "next" Gram point sample is taken at the end of the
+// last completed interval.
+// *******************************************************************
+int HardyZWindow(struct TURCTX *ctx, struct TURING tur)
+{
+mpfr_t	One;
+int		i, Completed;
+
+// -------------------------------------------------------------------
+// The 't' text of each sample is written as the sample is computed
+// (see TextSample), and by TextInterval for the rest, so we start the
+// window with none.
+// -------------------------------------------------------------------
+for(i=0; i < (tur.CountGram * ctx->CountZ) + 2; i++) {
+	ctx->tText[i * TUR_T_TEXT_MAX] = '\0';
+	}
+
+// -------------------------------------------------------------------
+// With -q, only the Gram intervals not settled by Gram's law are
+// sampled (see ClassTuring.c).
+// -------------------------------------------------------------------
+if(tur.Classify == true) {
+	Completed = ClassHardyZWindow(ctx, tur);
+	return(tur.Rosser == true ? RosserScan(ctx, tur, Completed) : Completed);
 	}
 
+// -------------------------------------------------------------------
+// With -w, whole Gram intervals are handed out to worker threads.
+// -------------------------------------------------------------------
+if(tur.Workers > 1) {
+	Completed = PoolHardyZWindow(ctx, tur);
+	return(tur.Rosser == true ? RosserScan(ctx, tur, Completed) : Completed);
+	}
+
+// -------------------------------------------------------------------
+// With -R, we compute one Gram interval at a time (see RosserTuring.c).
+// -------------------------------------------------------------------
+if(tur.Rosser == true) {
+	return(RosserHardyZWindow(ctx, tur));
+	}
+
+mpfr_inits2 (hgt_init.DefaultBits, One, (mpfr_ptr) 0);
+mpfr_set_ui(One, 1, MPFR_RNDN);
+
 // -------------------------------------------------------------------
 // We next compute and  update our GRAMLIST structure with the Hardy Z 
 // values at the interval points for that Gram point.  
@@ -105,21 +522,67 @@ for(i=0; i < tur.CountGram; i++) {
 // "lenSubInterval" before the next Gram point.
 // -------------------------------------------------------------------
 fprintf(stderr, "Processing Gram interval: ");
-for(i=0; i < tur.CountGram; i++) {
-	HardyZWithCount(gList[i].Gram, gList[i].lenSubInterval, tur.CountZ, i, HardyZCallbackA);
+for(i=0; i < tur.CountGram && StopRequested == 0; i++) {
+	if(CacheInterval(ctx, tur, i) == 0) {
+		if(tur.Mixed == true) {
+			ctx->sweep.MixedEscalated += MixedInterval(ctx, tur, i);
+			}
+		else {
+			TimedHardyZ(ctx->gList[i].Gram, ctx->gList[i].lenSubInterval, tur.CountZ, 
+				TUR_CALLER(ctx, i), HardyZCallbackA);
+			}
+		CachePutInterval(ctx, tur, i);
+		}
+	TextInterval(ctx, tur, i);
 	fprintf(stderr, "%d..", i);
 	}
 fprintf(stderr, "\n\n");
+Completed = i;
 
 // -------------------------------------------------------------------
 // At this point, we need two more Hardy Z values: (1) the value at the
 // point that is "lenSubInterval" before the first Gram point, and (2)
 // the value at the first Gram point after our "CountGram" Gram points.
-// -------------------------------------------------------------------
-mpfr_sub (Temp1, gList[0].Gram, gList[0].lenSubInterval, MPFR_RNDN);
-mpfr_set_ui(Temp2, 1, MPFR_RNDN);
-HardyZWithCount(Temp1, Temp2, 1, 0, HardyZCallbackB);
-HardyZWithCount(gList[tur.CountGram].Gram, Temp2, 1, tur.CountGram, HardyZCallbackA);
+// In a later sweep window, the first of these was carried from the
+// previous window.
+// -------------------------------------------------------------------
+if(ctx->sweep.Window == 0) {
+	mpfr_sub (ctx->tBefore, ctx->gList[0].Gram, ctx->gList[0].lenSubInterval, MPFR_RNDN);
+	if(CachePoint(ctx, tur, 0) == 0) {
+		if(tur.Mixed == true) {
+			ctx->sweep.MixedEscalated += MixedHardyZ(ctx, tur, 0);
+			}
+		else {
+			TimedHardyZ(ctx->tBefore, One, 1, TUR_CALLER(ctx, 0), HardyZCallbackB);
+			}
+		CachePutPoint(ctx, tur, 0);
+		}
+	}
+if(CachePoint(ctx, tur, (Completed * ctx->CountZ) + 1) == 0) {
+	if(tur.Mixed == true) {
+		tur.CountGram = Completed;
+		ctx->sweep.MixedEscalated += MixedHardyZ(ctx, tur, (Completed * ctx->CountZ) + 1);
+		}
+	else {
+		TimedHardyZ(ctx->gList[Completed].Gram, One, 1, TUR_CALLER(ctx, Completed), 
+			HardyZCallbackA);
+		}
+	CachePutPoint(ctx, tur, (Completed * ctx->CountZ) + 1);
+	}
+
+mpfr_clears (One, (mpfr_ptr) 0);
+return(Completed);
+}
+
+
+// *******************************************************************
+// With the Hardy Z values for the current window in hand, we classify
+// the Gram points and locate the zero crossings and possible Lehmer
+// points.
+// *******************************************************************
+int AnalyzeWindow(struct TURCTX *ctx, struct TURING tur)
+{
+int		i, j, hzNum;
 
 // -------------------------------------------------------------------
 // We now have the information to determine whether our Gram points are 
@@ -127,8 +590,8 @@ HardyZWithCount(gList[tur.CountGram].Gram, Temp2, 1, tur.CountGram, HardyZCallba
 // -------------------------------------------------------------------
 double	GoodTest;
 for(i=0; i <= tur.CountGram; i++) {
-	GoodTest = gList[i].MinusOneToN * hInfo[(i * CountZ) + 1].hzValue;
-	gList[i].Good = GoodTest > 0 ? true : false;
+	GoodTest = ctx->gList[i].MinusOneToN * ctx->hInfo[(i * ctx->CountZ) + 1].hzValue;
+	ctx->gList[i].Good = GoodTest > 0 ? true : false;
 	}
 
 // -------------------------------------------------------------------
@@ -137,19 +600,22 @@ for(i=0; i <= tur.CountGram; i++) {
 // has an even or odd number of zeros.
 // -------------------------------------------------------------------
 for(i=0; i < tur.CountGram; i++) {
-	gList[i].OddZeros = gList[i].Good == gList[i+1].Good ? true : false;
+	ctx->gList[i].OddZeros = ctx->gList[i].Good == ctx->gList[i+1].Good ? true : false;
 	}
 
 // -------------------------------------------------------------------
 // Compute the rise (fall) between computed Hardy Z values. With
 // that, compute whether the interval is moving towards or away
-// from zero.
+// from zero.  In a later sweep window, hInfo[0] and hInfo[1] were 
+// carried (with their flags) from the previous window.
 // -------------------------------------------------------------------
-hInfo[0].hzRise = 0;
-hzNum = (tur.CountGram * CountZ) + 1;
+if(ctx->sweep.Window == 0) {
+	ctx->hInfo[0].hzRise = 0;
+	}
+hzNum = (tur.CountGram * ctx->CountZ) + 1;
 for (i = 1; i <= hzNum; i++) {
-	hInfo[i].hzRise     = hInfo[i].hzValue - hInfo[i-1].hzValue;
-	hInfo[i].TowardZero = hInfo[i].hzRise * hInfo[i].hzValue 
+	ctx->hInfo[i].hzRise     = ctx->hInfo[i].hzValue - ctx->hInfo[i-1].hzValue;
+	ctx->hInfo[i].TowardZero = ctx->hInfo[i].hzRise * ctx->hInfo[i].hzValue 
 		> 0 ? false : true;
 	}
 
@@ -159,20 +625,25 @@ for (i = 1; i <= hzNum; i++) {
 int		idx;
 double	TestCross;
 
-hInfo[0].ZeroCross = hInfo[1].ZeroCross = false;
+if(ctx->sweep.Window == 0) {
+	ctx->hInfo[0].ZeroCross = ctx->hInfo[1].ZeroCross = false;
+	}
 for(i=0; i < tur.CountGram; i++) {
-	gList[i].ZerosFound = 0;
-	idx = (i * CountZ) + 2;
+	ctx->gList[i].ZerosFound = 0;
+	idx = (i * ctx->CountZ) + 2;
 	for(j = 0; j < tur.CountZ; j++) {
-		TestCross = hInfo[idx + j].hzValue * hInfo[idx + j - 1].hzValue;
+		TestCross = ctx->hInfo[idx + j].hzValue * ctx->hInfo[idx + j - 1].hzValue;
 		if(TestCross < 0) {
-			hInfo[idx + j].ZeroCross = true;
-			gList[i].ZerosFound += 1;
+			ctx->hInfo[idx + j].ZeroCross = true;
+			ctx->gList[i].ZerosFound += 1;
 			}
 		else {
-			hInfo[idx + j].ZeroCross = false;
+			ctx->hInfo[idx + j].ZeroCross = false;
 			}
 		}
+	if(tur.Classify == true && ctx->gList[i].Settled == true) {
+		ClassAnalyze(ctx, i);
+		}
 	}
 
 // -------------------------------------------------------------------
@@ -180,30 +651,42 @@ for(i=0; i < tur.CountGram; i++) {
 // crossing. (Or, we have a Lehmer failure).  NOTE: the below
 // setting of hInfo[i].Lehmer works because Lehmer is a bool.
 // -------------------------------------------------------------------
-hInfo[0].Lehmer = false;
-hzNum = (tur.CountGram * CountZ) + 1;
+if(ctx->sweep.Window == 0) {
+	ctx->hInfo[0].Lehmer = false;
+	}
+hzNum = (tur.CountGram * ctx->CountZ) + 1;
 for (i = 1; i <= hzNum; i++) {
-	hInfo[i].Lehmer =
-		(hInfo[i].TowardZero == false 
-		&& hInfo[i].ZeroCross == false  
-		&& hInfo[i-1].TowardZero == true);
+	ctx->hInfo[i].Lehmer =
+		(ctx->hInfo[i].TowardZero == false 
+		&& ctx->hInfo[i].ZeroCross == false  
+		&& ctx->hInfo[i-1].TowardZero == true);
 	}
+return(1);
+}
 
-TuringReport(tur);
 
-mpfr_clears (t, nOfGram, Accuracy, HardyZ, Temp1, Temp2, (mpfr_ptr) 0);
+// *******************************************************************
+// Before starting a new sweep window, we carry over from the window 
+// just completed (whose size is tur.CountGram): (1) its last Gram point
+// (and 'n' and parity), which becomes our new gList[0], (2) the Hardy
+// Z sample at that Gram point, which becomes our new hInfo[1], and 
+// (3) the Hardy Z sample just before that Gram point, which becomes 
+// our new hInfo[0].  So the sweep is one continuous set of samples.
+// *******************************************************************
+int CarryWindow(struct TURCTX *ctx, struct TURING tur)
+{
+int		Last = tur.CountGram;
 
-for(i=0; i <= tur.CountGram; i++) {
-	mpfr_clears (gList[i].Gram, gList[i].lenInterval, gList[i].n, 
-	gList[i].lenSubInterval, (mpfr_ptr) 0);
-	}
+mpfr_mul_si (ctx->tBefore, ctx->gList[Last-1].lenSubInterval, ctx->CountZ - 1, MPFR_RNDN);
+mpfr_add (ctx->tBefore, ctx->gList[Last-1].Gram, ctx->tBefore, MPFR_RNDN);
+ctx->hInfo[0] = ctx->hInfo[Last * ctx->CountZ];
+ctx->hInfo[1] = ctx->hInfo[(Last * ctx->CountZ) + 1];
 
-// -------------------------------------------------------------------
-// Free the MPFR variables that held the coefficients.
-// -------------------------------------------------------------------
-CloseCoeffMPFR();
-CloseMPFR();
-return(1);	
+mpfr_swap (ctx->gList[0].Gram, ctx->gList[Last].Gram);
+mpfr_swap (ctx->gList[0].n, ctx->gList[Last].n);
+ctx->gList[0].MinusOneToN = ctx->gList[Last].MinusOneToN;
+ctx->gList[0].Good = ctx->gList[Last].Good;
+return(1);
 }
 
 
@@ -211,12 +694,10 @@ return(1);
 // This function provides our report of the Gram points and Hardy Z
 // values needed to apply Turing's Method.
 // *******************************************************************
-int TuringReport(struct TURING tur)
+int TuringReport(struct TURCTX *ctx, struct TURING tur)
 {
 int		i, j, idx;
-mpfr_t	Temp1;
-
-mpfr_inits2 (hgt_init.DefaultBits, Temp1, (mpfr_ptr) 0);
+char	sT[TUR_T_TEXT_MAX];
 
 // -------------------------------------------------------------------
 // In a verbose report, we show: (1) the 'n' and Gram point closst to 
@@ -227,24 +708,24 @@ mpfr_inits2 (hgt_init.DefaultBits, Temp1, (mpfr_ptr) 0);
 // length for the "CountGram" Gram points.
 // -------------------------------------------------------------------
 if(tur.Verbose == true) {
-	mpfr_printf("This report begins with n = %.0Rf and t = g(n) = %.*Rf\n\n", gList[0].n, 
-		tur.OutputDP, gList[0].Gram);
+	mpfr_fprintf(ctx->fpOut, "This report begins with n = %.0Rf and t = g(n) = %.*Rf\n\n", ctx->gList[0].n, 
+		tur.OutputDP, ctx->gList[0].Gram);
 
-	printf("We must find K = %u consecutive Gram blocks that satisfy Rosser's Rule\n\n", 
-			ComputeTuringK(gList[0].Gram));
+	fprintf(ctx->fpOut, "We must find K = %u consecutive Gram blocks that satisfy Rosser's Rule\n\n", 
+			ComputeTuringK(ctx->gList[0].Gram));
 
 	for(i=0; i <= tur.CountGram; i++) {
-		mpfr_printf("For n = %.0Rf, Gram = %.*Rf, -1^{n} = %2d, Hardy Z = %*.*f, Gram good = %s \n", 
-			gList[i].n, tur.OutputDP, gList[i].Gram, gList[i].MinusOneToN, TUR_HARDY_WIDTH, 
+		mpfr_fprintf(ctx->fpOut, "For n = %.0Rf, Gram = %.*Rf, -1^{n} = %2d, Hardy Z = %*.*f, Gram good = %s \n", 
+			ctx->gList[i].n, tur.OutputDP, ctx->gList[i].Gram, ctx->gList[i].MinusOneToN, TUR_HARDY_WIDTH, 
 			TUR_HARDY_DECIMALS, 
-			hInfo[(i * CountZ) + 1].hzValue, 
-			gList[i].Good == true ? "true" : "false" );						
+			ctx->hInfo[(i * ctx->CountZ) + 1].hzValue, 
+			ctx->gList[i].Good == true ? "true" : "false" );						
 		}
 	
-	printf("\nThe Gram interval lengths and sub-interval lengths are as follows:\n\n");
+	fprintf(ctx->fpOut, "\nThe Gram interval lengths and sub-interval lengths are as follows:\n\n");
 	for(i=0; i < tur.CountGram; i++) {
-		mpfr_printf("For Gram = %.16Rf, Interval length = %.16Rf, SubInterval len = %.16Rf \n", 
-			gList[i].Gram, gList[i].lenInterval, gList[i].lenSubInterval);
+		mpfr_fprintf(ctx->fpOut, "For Gram = %.16Rf, Interval length = %.16Rf, SubInterval len = %.16Rf \n", 
+			ctx->gList[i].Gram, ctx->gList[i].lenInterval, ctx->gList[i].lenSubInterval);
 		}
 
 // -------------------------------------------------------------------
@@ -257,28 +738,30 @@ if(tur.Verbose == true) {
 	char	AsExpected[] = "Even/Odd As Expected";
 	char *  Message;
 
-	printf("\n");
+	fprintf(ctx->fpOut, "\n");
 	for(i=0; i < tur.CountGram; i++) {
 		Message = AsExpected;
-		if(gList[i].Good == gList[i+1].Good) {  // so, expecting odd number of zeros
-			if((gList[i].ZerosFound % 2) == 0)	// actual found = even
+		if(ctx->gList[i].Good == ctx->gList[i+1].Good) {  // so, expecting odd number of zeros
+			if((ctx->gList[i].ZerosFound % 2) == 0)	// actual found = even
 			Message = ExpectOdd;
 			}
-		else if((gList[i].ZerosFound % 2) != 0)	{ // expecting even, but actual found = odd
+		else if((ctx->gList[i].ZerosFound % 2) != 0)	{ // expecting even, but actual found = odd
 			Message = ExpectEven;
 			}
-		printf("Gram idx = %d, Zeros Found = %d, %s \n", i, gList[i].ZerosFound, Message);
+		fprintf(ctx->fpOut, "Gram idx = %d, Zeros Found = %d, %s \n", i, ctx->gList[i].ZerosFound, Message);
 		}
-	printf("\nThe requested Turing Method data is as follows:\n\n");
+	if(tur.Refine > 0) {
+		RefineReport(ctx, tur);
+		}
+	fprintf(ctx->fpOut, "\nThe requested Turing Method data is as follows:\n\n");
 	}
 
 // -------------------------------------------------------------------
 // We show the 't' and Hardy Z values of the sub-interval before
 // the first Gram point.
 // -------------------------------------------------------------------
-mpfr_sub (Temp1, gList[0].Gram, gList[0].lenSubInterval, MPFR_RNDN);
-mpfr_printf("G( 0) -1, %.*Rf, %*.*f \n", tur.OutputDP, Temp1, TUR_HARDY_WIDTH, 
-			TUR_HARDY_DECIMALS, hInfo[0].hzValue);
+mpfr_fprintf(ctx->fpOut, "G( 0) -1, %.*Rf, %*.*f \n", tur.OutputDP, ctx->tBefore, TUR_HARDY_WIDTH, 
+			TUR_HARDY_DECIMALS, ctx->hInfo[0].hzValue);
 
 // -------------------------------------------------------------------
 // For the "CountGram" Gram points, we show the 't' and Hardy Z
@@ -288,34 +771,134 @@ mpfr_printf("G( 0) -1, %.*Rf, %*.*f \n", tur.OutputDP, Temp1, TUR_HARDY_WIDTH,
 // -------------------------------------------------------------------
 for(i=0; i < tur.CountGram; i++) {
 	for(j = 0; j < tur.CountZ; j++) {
-		mpfr_mul_si (Temp1, gList[i].lenSubInterval, j, MPFR_RNDN);
-		mpfr_add (Temp1, gList[i].Gram, Temp1, MPFR_RNDN);
-		mpfr_printf("G(%2d) %2d, %.*Rf, %*.*f,  %10.6f, %9s, %7s \n", i, j, 
-			tur.OutputDP, Temp1, TUR_HARDY_WIDTH, TUR_HARDY_DECIMALS, 
-			hInfo[(i * CountZ) + 1 +j ].hzValue,
-			hInfo[(i * CountZ) + 1 +j ].hzRise,
-			hInfo[(i * CountZ) + 1 +j ].ZeroCross == true ? "Crossing" : " ",
-			hInfo[(i * CountZ) + 1 +j ].Lehmer == true ? "Lehmer" : " ");
+		if(j == 1 && tur.Classify == true && ctx->gList[i].Settled == true) {
+			fprintf(ctx->fpOut, "G(%2d)     settled by Gram's law: sub-intervals not sampled \n", i);
+			break;
+			}
+		fprintf(ctx->fpOut, "G(%2d) %2d, %s, %*.*f,  %10.6f, %9s, %7s \n", i, j, 
+			&ctx->tText[((i * ctx->CountZ) + 1 + j) * TUR_T_TEXT_MAX], TUR_HARDY_WIDTH, TUR_HARDY_DECIMALS, 
+			ctx->hInfo[(i * ctx->CountZ) + 1 +j ].hzValue,
+			ctx->hInfo[(i * ctx->CountZ) + 1 +j ].hzRise,
+			ctx->hInfo[(i * ctx->CountZ) + 1 +j ].ZeroCross == true ? "Crossing" : " ",
+			ctx->hInfo[(i * ctx->CountZ) + 1 +j ].Lehmer == true ? "Lehmer" : " ");
 		}
 	}
 // -------------------------------------------------------------------
 // We show the 't' and Hardy Z values (and Crossing / Lehmer info) of 
 //the Gram point that immediately follows our "CountGram" Gram points.
 // -------------------------------------------------------------------	
-idx = (tur.CountGram * CountZ) + 1;
-mpfr_printf("G(%2d)  0, %.*Rf, %*.*f,  %10.6f, %9s, %7s \n", tur.CountGram, tur.OutputDP, 
-			gList[tur.CountGram].Gram, TUR_HARDY_WIDTH, TUR_HARDY_DECIMALS, 
-			hInfo[idx].hzValue,
-			hInfo[idx].hzRise,
-			hInfo[idx].ZeroCross == true ? "Crossing" : " ",
-			hInfo[idx].Lehmer == true ? "Lehmer" : " ");
-
-mpfr_clears (Temp1, (mpfr_ptr) 0);
+idx = (tur.CountGram * ctx->CountZ) + 1;
+mpfr_snprintf(sT, sizeof(sT), "%.*Rf", tur.OutputDP, ctx->gList[tur.CountGram].Gram);
+fprintf(ctx->fpOut, "G(%2d)  0, %s, %*.*f,  %10.6f, %9s, %7s \n", tur.CountGram, sT, 
+			TUR_HARDY_WIDTH, TUR_HARDY_DECIMALS, 
+			ctx->hInfo[idx].hzValue,
+			ctx->hInfo[idx].hzRise,
+			ctx->hInfo[idx].ZeroCross == true ? "Crossing" : " ",
+			ctx->hInfo[idx].Lehmer == true ? "Lehmer" : " ");
 
+// -------------------------------------------------------------------
+// The report stream is fully buffered (see main and DaemonServe), so
+// we flush once per report, before the next window's progress goes
+// to stderr (and, with -D, so the client sees each window as it ends).
+// -------------------------------------------------------------------
+fflush(ctx->fpOut);
 return(1);	
 }
 
 
+// *******************************************************************
+// Each sample's 't' is converted to report text once, into tText, and
+// TuringReport then just copies the text out.  Where a sample is
+// computed from an MPFR 't' (in the HardyZWithCount callbacks, and in
+// MixedHardyZ), we convert that 't' there, by whichever thread
+// computed it (so, with -w, in parallel).
+// *******************************************************************
+int TextSample(struct TURCTX *ctx, int idx, mpfr_t t)
+{
+mpfr_snprintf(&ctx->tText[idx * TUR_T_TEXT_MAX], TUR_T_TEXT_MAX, "%.*Rf", ctx->OutputDP, t);
+return(1);
+}
+
+
+// *******************************************************************
+// Once the samples of Gram interval i are in hInfo, we convert the 't'
+// of any that have no text yet (those found in the -H cache, carried
+// from the previous window, or computed in double precision on a -E
+// grid).  The 't' values are those of HardyT.
+// *******************************************************************
+int TextInterval(struct TURCTX *ctx, struct TURING tur, int i)
+{
+mpfr_t	t;
+int		j, idx;
+
+idx = (i * ctx->CountZ) + 1;
+for(j = 0; j < ctx->CountZ && ctx->tText[(idx + j) * TUR_T_TEXT_MAX] != '\0'; j++)
+	;
+if(j == ctx->CountZ) {
+	return(1);
+	}
+mpfr_inits2 (hgt_init.DefaultBits, t, (mpfr_ptr) 0);
+for(; j < ctx->CountZ; j++) {
+	if(ctx->tText[(idx + j) * TUR_T_TEXT_MAX] == '\0') {
+		HardyT(ctx, t, tur, idx + j);
+		TextSample(ctx, idx + j, t);
+		}
+	}
+mpfr_clears (t, (mpfr_ptr) 0);
+return(1);
+}
+
+
+// *******************************************************************
+// In a sweep, we keep running totals over all windows.  Each Gram 
+// point and each Hardy Z sample is counted in exactly one window (the 
+// last Gram point of a window is counted as the first of the next,
+// and the last Gram point of the sweep with the last window).
+// *******************************************************************
+int SweepTally(struct TURCTX *ctx, struct TURING tur)
+{
+int		i, j, idx;
+
+for(i=0; i < tur.CountGram; i++) {
+	ctx->sweep.ZerosFound += ctx->gList[i].ZerosFound;
+	if(tur.Grid == true && ctx->gList[i].GridBound > ctx->sweep.GridBound) {
+		ctx->sweep.GridBound = ctx->gList[i].GridBound;
+		}
+	if(ctx->gList[i].Good == false) {
+		ctx->sweep.BadGram += 1;
+		}
+	if((ctx->gList[i].ZerosFound % 2 == 0) == ctx->gList[i].OddZeros) {
+		ctx->sweep.BadParity += 1;
+		}
+	idx = (i * ctx->CountZ) + 2;
+	for(j = 0; j < tur.CountZ; j++) {
+		if(ctx->hInfo[idx + j].Lehmer == true) {
+			ctx->sweep.Lehmer += 1;
+			}
+		}
+	}
+if((ctx->sweep.Done + tur.CountGram == ctx->sweep.Total || ctx->sweep.RosserDone == true)
+	&& ctx->gList[tur.CountGram].Good == false) {
+	ctx->sweep.BadGram += 1;
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// At the end of a sweep, we report the totals over all windows.
+// *******************************************************************
+int SweepReport(struct TURCTX *ctx)
+{
+fprintf(ctx->fpOut, "Sweep complete: %ju Gram intervals in %ju windows\n", 
+	(uintmax_t) ctx->sweep.Done, (uintmax_t) ctx->sweep.Window);
+fprintf(ctx->fpOut, "Zeros Found = %ju, Bad Gram points = %ju, Even/Odd failures = %ju, Possible Lehmer = %ju \n",
+	(uintmax_t) ctx->sweep.ZerosFound, (uintmax_t) ctx->sweep.BadGram, 
+	(uintmax_t) ctx->sweep.BadParity, (uintmax_t) ctx->sweep.Lehmer);
+return(1);
+}
+
+
 // *******************************************************************
 // We compute the K value used in Turing's Methods, where K is the 
 // smallest positive integer such that:
@@ -350,7 +933,7 @@ return(K);
 
 
 // *******************************************************************
-// Following are the two callback functions passed to and then called 
+// Following are the callback functions passed to and then called 
 // by the HardyZWithCount library function.
 //
 // NOTE: To avoid the gcc compiler warning "warning unused parameter"
@@ -368,17 +951,35 @@ return(K);
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
+// -------------------------------------------------------------------
+// In each callback, CallerID is TUR_CALLER(ctx, n).  With 
+// HardyZCallbackA, n is the Gram interval.  With HardyZCallbackC, n is
+// the hInfo index of the first value computed (so any run of 
+// consecutive samples can be computed).
+// -------------------------------------------------------------------
 int HardyZCallbackA(mpfr_t t, mpfr_t HardyZ, int i, int CallerID) 
 {
-int	idx = (CallerID * CountZ) + 1 + i;
-hInfo[idx].hzValue = mpfr_get_d (HardyZ, MPFR_RNDN);
+struct TURCTX *	ctx = TuringCtxOf(CallerID);
+int				idx = ((CallerID & TUR_CTX_MASK) * ctx->CountZ) + 1 + i;
+ctx->hInfo[idx].hzValue = mpfr_get_d (HardyZ, MPFR_RNDN);
+TextSample(ctx, idx, t);
 return(1);
 }
 
 
 int HardyZCallbackB(mpfr_t t, mpfr_t HardyZ, int i, int CallerID) 
 {
-hInfo[0].hzValue = mpfr_get_d (HardyZ, MPFR_RNDN);
+struct TURCTX *	ctx = TuringCtxOf(CallerID);
+ctx->hInfo[0].hzValue = mpfr_get_d (HardyZ, MPFR_RNDN);
+return(1);
+}
+
+
+int HardyZCallbackC(mpfr_t t, mpfr_t HardyZ, int i, int CallerID) 
+{
+struct TURCTX *	ctx = TuringCtxOf(CallerID);
+ctx->hInfo[(CallerID & TUR_CTX_MASK) + i].hzValue = mpfr_get_d (HardyZ, MPFR_RNDN);
+TextSample(ctx, (CallerID & TUR_CTX_MASK) + i, t);
 return(1);
 }
 
@@ -393,6 +994,6 @@ int64_t		Var;
 printf("Var = %jd \n", (intmax_t)Var);
 */
 
-// For testing:
+// For testing (these are the cases of bench/suite.sh, make bench):
 // Lehmer pair: 7005.06266  7005.10056 -- also near 10854395965 and 35615956517
 // Lehmer triplet: 12125271.88276506   12125272.07355435   12125272.2576189 
\ No newline at end of file
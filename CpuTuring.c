@@ -0,0 +1,235 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#ifndef _WIN32
+#define _GNU_SOURCE					// sched_getaffinity and friends
+#endif
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <mpfr.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+#include "hgt.h"
+#include "turing.h"
+
+#ifndef _WIN32
+static _Thread_local cpu_set_t	SavedMask;	// see CpuSave
+static _Thread_local bool		Saved = false;
+
+static int		CpuNodeList(int Node, cpu_set_t *pAllowed, int *Cpu, int Count, int Max);
+#endif
+
+
+// *******************************************************************
+// We return the number of CPUs this process may run on (which, under
+// taskset or a cgroup cpuset, may be fewer than the machine has).
+// *******************************************************************
+int CpuCount(void)
+{
+#ifdef _WIN32
+SYSTEM_INFO		si;
+
+GetSystemInfo(&si);
+return(si.dwNumberOfProcessors > 0 ? (int) si.dwNumberOfProcessors : 1);
+#else
+cpu_set_t		Allowed;
+
+if(sched_getaffinity(0, sizeof(Allowed), &Allowed) != 0) {
+	return(1);
+	}
+return(CPU_COUNT(&Allowed) > 0 ? CPU_COUNT(&Allowed) : 1);
+#endif
+}
+
+
+// *******************************************************************
+// We resolve -w auto and -k auto (given as 0) from the CPU count.
+// The workers are chosen first: one per CPU (or per -k CPUs, if -k
+// was given), but no more than there are tasks in a window.  Then
+// -k auto shares out whatever CPUs each worker is left with, up to
+// the libHGT limit of TUR_THREADS_MAX.
+// *******************************************************************
+int CpuAuto(struct TURING *pTur)
+{
+int		Cpus;
+
+Cpus = CpuCount();
+if(pTur->Workers == 0) {
+	pTur->Workers = Cpus / (pTur->Threads > 0 ? pTur->Threads : 1);
+	pTur->Workers = pTur->Workers < pTur->CountGram + 2 ? pTur->Workers : pTur->CountGram + 2;
+	pTur->Workers = pTur->Workers < TUR_WORKERS_MAX ? pTur->Workers : TUR_WORKERS_MAX;
+	pTur->Workers = pTur->Workers > 0 ? pTur->Workers : 1;
+	}
+if(pTur->Threads == 0) {
+	pTur->Threads = Cpus / pTur->Workers;
+	pTur->Threads = pTur->Threads < TUR_THREADS_MAX ? pTur->Threads : TUR_THREADS_MAX;
+	pTur->Threads = pTur->Threads > 0 ? pTur->Threads : 1;
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// We fill Cpu with the CPUs this process may run on, grouped by NUMA
+// node (node 0's CPUs first, and so on), and return how many there
+// are.  A run of neighbouring entries thus stays on one node where it
+// can.  Any CPU not listed under a node (or every CPU, if the system
+// does not report nodes) follows in CPU number order.
+// *******************************************************************
+int CpuPlan(int *Cpu, int Max)
+{
+#ifdef _WIN32
+int			i;
+
+for(i=0; i < Max && i < CpuCount(); i++) {
+	Cpu[i] = i;
+	}
+return(i);
+#else
+cpu_set_t	Allowed;
+int			i, Node, Count = 0;
+
+if(sched_getaffinity(0, sizeof(Allowed), &Allowed) != 0) {
+	return(0);
+	}
+for(Node = 0; Node < TUR_NODES_MAX && Count < Max; Node++) {
+	Count = CpuNodeList(Node, &Allowed, Cpu, Count, Max);
+	}
+for(i=0; i < CPU_SETSIZE && Count < Max; i++) {
+	if(CPU_ISSET(i, &Allowed)) {
+		Cpu[Count++] = i;
+		CPU_CLR(i, &Allowed);
+		}
+	}
+return(Count);
+#endif
+}
+
+
+// *******************************************************************
+// We pin the calling thread to Width CPUs of the CpuPlan list, from
+// entry First (wrapping around if the list is short).  Any threads
+// libHGT starts for -k inherit the same CPUs, and the memory the
+// thread then allocates (such as its MPFR temporaries) is placed on
+// their node by the kernel's first-touch policy.  We return 0 if the
+// thread could not be pinned.
+// *******************************************************************
+int CpuPin(int *Cpu, int Count, int First, int Width)
+{
+#ifdef _WIN32
+(void) Cpu; (void) Count; (void) First; (void) Width;
+return(0);
+#else
+cpu_set_t	Mask;
+int			i;
+
+if(Count < 1) {
+	return(0);
+	}
+CPU_ZERO(&Mask);
+for(i=0; i < Width && i < Count; i++) {
+	CPU_SET(Cpu[(First + i) % Count], &Mask);
+	}
+return(pthread_setaffinity_np(pthread_self(), sizeof(Mask), &Mask) == 0 ? 1 : 0);
+#endif
+}
+
+
+// *******************************************************************
+// With -P and a single worker (-w 1), no pool is started and the main
+// thread does all the work, so we pin it (and so its -k threads) as
+// worker 0 would be pinned.  We return 0 if it could not be pinned.
+// *******************************************************************
+int CpuPinMain(int Threads)
+{
+int *	Cpu;
+int		Count, Result;
+
+if((Cpu = malloc(TUR_CPU_MAX * sizeof(int))) == NULL) {
+	return(0);
+	}
+Count = CpuPlan(Cpu, TUR_CPU_MAX);
+Result = CpuPin(Cpu, Count, 0, Threads);
+free(Cpu);
+return(Result);
+}
+
+
+// *******************************************************************
+// The main thread is also worker 0, so PoolHardyZWindow saves its
+// CPUs before pinning it, and restores them afterwards.
+// *******************************************************************
+int CpuSave(void)
+{
+#ifndef _WIN32
+Saved = pthread_getaffinity_np(pthread_self(), sizeof(SavedMask), &SavedMask) == 0;
+#endif
+return(1);
+}
+
+
+int CpuRestore(void)
+{
+#ifndef _WIN32
+if(Saved == true) {
+	pthread_setaffinity_np(pthread_self(), sizeof(SavedMask), &SavedMask);
+	Saved = false;
+	}
+#endif
+return(1);
+}
+
+
+#ifndef _WIN32
+// *******************************************************************
+// We append to Cpu (which holds Count entries) the allowed CPUs of
+// the given NUMA node (no more than Max in all), read from its sysfs
+// cpulist (such as "0-7,16-23"), and remove them from pAllowed.  We
+// return the new count.
+// *******************************************************************
+static int CpuNodeList(int Node, cpu_set_t *pAllowed, int *Cpu, int Count, int Max)
+{
+FILE	*fp;
+char	sPath[TUR_PATH_MAX];
+char	sList[TUR_CKPT_LINE_MAX];
+char	*p, *pEnd;
+long	Low, High, i;
+
+snprintf(sPath, sizeof(sPath), "/sys/devices/system/node/node%d/cpulist", Node);
+if((fp = fopen(sPath, "r")) == NULL) {
+	return(Count);
+	}
+if(fgets(sList, sizeof(sList), fp) == NULL) {
+	sList[0] = '\0';
+	}
+fclose(fp);
+
+for(p = sList; isdigit((unsigned char) *p); p = (*pEnd == ',') ? pEnd + 1 : pEnd) {
+	Low = High = strtol(p, &pEnd, 10);
+	if(*pEnd == '-') {
+		High = strtol(pEnd + 1, &pEnd, 10);
+		}
+	for(i = Low; i <= High && i < CPU_SETSIZE && Count < Max; i++) {
+		if(CPU_ISSET(i, pAllowed)) {
+			Cpu[Count++] = (int) i;
+			CPU_CLR(i, pAllowed);
+			}
+		}
+	}
+return(Count);
+}
+#endif
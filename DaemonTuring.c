@@ -0,0 +1,481 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <time.h>
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <errno.h>
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <mpfr.h>
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#endif
+
+#include "hgt.h"
+#include "turing.h"
+
+#ifndef _WIN32
+struct DAEMONREQ {
+	int				fd;				// the client's connection
+	struct timespec	Arrived;		// when it was accepted
+};
+
+struct DAEMONWORKER {
+	pthread_t		Thread;
+	struct TURING	tur;			// the server's parameters (each request's defaults)
+	struct TURCTX *	ctx;			// allocated once, used by every request
+};
+
+static pthread_mutex_t		DaemonLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t		NotEmpty = PTHREAD_COND_INITIALIZER;
+static struct DAEMONREQ		Queue[TUR_DAEMON_QUEUE_MAX];	// a ring
+static int					QueueHead, QueueCount;
+static bool					Draining;		// T/F: no more requests will be queued
+static volatile sig_atomic_t	DaemonStop = 0;
+
+// -------------------------------------------------------------------
+// Request statistics (under DaemonLock).  Latency is from accept to
+// the end of the reply, in a histogram of TUR_STATS_BUCKETS buckets,
+// four per power of 2 nanoseconds (as for the Hardy Z evaluations).
+// -------------------------------------------------------------------
+static uint64_t				Requests, Answered, Failed, Rejected;
+static double				WaitSum, LatencySum, LatencyMax;
+static uint64_t				Hist[TUR_STATS_BUCKETS];
+
+static void *		DaemonWorker(void *pArg);
+static int			DaemonRequest(struct DAEMONWORKER *pW, struct DAEMONREQ Req);
+static int			DaemonLine(char *sLine, struct TURING *pJob);
+static int			DaemonReport(FILE *fp);
+static double		DaemonPercentile(double Fraction);
+static double		DaemonSeconds(struct timespec *pStart, struct timespec *pEnd);
+static void			DaemonSignal(int Signal);
+#endif
+
+
+// *******************************************************************
+// With -D, we listen on a Unix-domain socket and answer requests, each
+// one line of command line parameters for one job, such as:
+//
+//		-t 7005.06 -g 4 -c 32 -v
+//
+// The reply is the report the same job would print from the command
+// line, streamed window by window, and then one line giving the
+// request's status and latency.  A request of "stats" is answered
+// with the server's request statistics instead.
+//
+// MPFR and the Hardy Z coefficients are set up once, and each of the
+// -w workers has its own context, allocated once; a worker takes a
+// whole request.  At most TUR_DAEMON_QUEUE_MAX requests wait for a
+// worker: when the queue is full, a new client is told so and turned
+// away at once.  SIGINT or SIGTERM stops the server after the
+// requests already queued are answered.
+// *******************************************************************
+int DaemonServe(struct TURING tur)
+{
+#ifdef _WIN32
+printf("The -D parameter (Unix-domain sockets) is not available on Windows.\n");
+(void) tur;
+return(0);
+#else
+struct sockaddr_un		Addr;
+struct sigaction		Action;
+struct timeval			Timeout;
+struct DAEMONWORKER *	Worker;
+struct DAEMONREQ		Req;
+const char				sBusy[] = "Busy: too many requests are waiting, please try again \n";
+char					sLine[TUR_BATCH_LINE_MAX];
+int						Listen, fd, i, Workers, Started = 0, Result = 1;
+
+if(strlen(tur.DaemonSocket) >= sizeof(Addr.sun_path)) {
+	printf("The -D socket path is too long (at most %zu characters).\n", sizeof(Addr.sun_path) - 1);
+	return(0);
+	}
+Workers = tur.Workers;
+tur.Workers = 1;
+tur.Pin = false;
+if((Worker = calloc(Workers, sizeof(struct DAEMONWORKER))) == NULL) {
+	printf("Out of memory \n");
+	return(0);
+	}
+
+memset(&Action, 0, sizeof(Action));
+Action.sa_handler = DaemonSignal;
+sigemptyset(&Action.sa_mask);
+sigaction(SIGINT, &Action, NULL);		// no SA_RESTART, so accept returns
+sigaction(SIGTERM, &Action, NULL);
+signal(SIGPIPE, SIG_IGN);				// a client that goes away is a write error
+
+memset(&Addr, 0, sizeof(Addr));
+Addr.sun_family = AF_UNIX;
+strcpy(Addr.sun_path, tur.DaemonSocket);
+unlink(tur.DaemonSocket);
+if((Listen = socket(AF_UNIX, SOCK_STREAM, 0)) < 0
+	|| bind(Listen, (struct sockaddr *) &Addr, sizeof(Addr)) != 0
+	|| listen(Listen, TUR_DAEMON_QUEUE_MAX) != 0) {
+	printf("Unable to listen on %s \n", tur.DaemonSocket);
+	if(Listen >= 0) {
+		close(Listen);
+		}
+	free(Worker);
+	return(0);
+	}
+
+TuringOpen(tur);
+for(i=0; i < Workers; i++) {
+	Worker[i].tur = tur;
+	if((Worker[i].ctx = TuringCtxNew(HGT_TUR_GRAM_PTS_MAX, HGT_TUR_SUBINTVL_MAX)) == NULL
+		|| pthread_create(&Worker[i].Thread, NULL, DaemonWorker, &Worker[i]) != 0) {
+		Result = 0;
+		break;
+		}
+	Started++;
+	}
+if(Result == 1) {
+	printf("Listening on %s: %d workers, at most %d requests waiting \n", tur.DaemonSocket,
+		Workers, TUR_DAEMON_QUEUE_MAX);
+	fflush(stdout);
+	}
+
+// -------------------------------------------------------------------
+// Accept clients until we are signalled.  A client that sends nothing
+// (or reads nothing) for TUR_DAEMON_TIMEOUT seconds is dropped, so it
+// cannot hold a worker.
+// -------------------------------------------------------------------
+Timeout.tv_sec = TUR_DAEMON_TIMEOUT;
+Timeout.tv_usec = 0;
+while(Result == 1 && DaemonStop == 0) {
+	if((fd = accept(Listen, NULL, NULL)) < 0) {
+		if(errno == EINTR || errno == ECONNABORTED) {
+			continue;
+			}
+		printf("Unable to accept a request on %s \n", tur.DaemonSocket);
+		break;
+		}
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &Timeout, sizeof(Timeout));
+	setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &Timeout, sizeof(Timeout));
+	Req.fd = fd;
+	clock_gettime(CLOCK_MONOTONIC, &Req.Arrived);
+
+	pthread_mutex_lock(&DaemonLock);
+	if(QueueCount == TUR_DAEMON_QUEUE_MAX) {
+		Rejected++;
+		pthread_mutex_unlock(&DaemonLock);
+		send(fd, sBusy, sizeof(sBusy) - 1, MSG_NOSIGNAL);
+		recv(fd, sLine, sizeof(sLine), MSG_DONTWAIT);	// any request sent, so close does not reset
+		close(fd);
+		continue;
+		}
+	Queue[(QueueHead + QueueCount) % TUR_DAEMON_QUEUE_MAX] = Req;
+	QueueCount++;
+	pthread_cond_signal(&NotEmpty);
+	pthread_mutex_unlock(&DaemonLock);
+	}
+
+// -------------------------------------------------------------------
+// Answer the requests already queued, then stop the workers.
+// -------------------------------------------------------------------
+close(Listen);
+unlink(tur.DaemonSocket);
+pthread_mutex_lock(&DaemonLock);
+Draining = true;
+pthread_cond_broadcast(&NotEmpty);
+pthread_mutex_unlock(&DaemonLock);
+for(i=0; i < Started; i++) {
+	pthread_join(Worker[i].Thread, NULL);
+	}
+for(i=0; i < Workers; i++) {
+	if(Worker[i].ctx != NULL) {
+		TuringCtxFree(Worker[i].ctx);
+		}
+	}
+TuringClose();
+free(Worker);
+
+printf("Daemon stopped. ");
+DaemonReport(stdout);
+return(Result);
+#endif
+}
+
+
+#ifndef _WIN32
+// *******************************************************************
+// Each worker takes requests from the queue, oldest first, until the
+// server is draining and the queue is empty.
+// *******************************************************************
+static void * DaemonWorker(void *pArg)
+{
+struct DAEMONWORKER *	pW = (struct DAEMONWORKER *) pArg;
+struct DAEMONREQ		Req;
+
+for(;;) {
+	pthread_mutex_lock(&DaemonLock);
+	while(QueueCount == 0 && Draining == false) {
+		pthread_cond_wait(&NotEmpty, &DaemonLock);
+		}
+	if(QueueCount == 0) {
+		pthread_mutex_unlock(&DaemonLock);
+		break;
+		}
+	Req = Queue[QueueHead];
+	QueueHead = (QueueHead + 1) % TUR_DAEMON_QUEUE_MAX;
+	QueueCount--;
+	pthread_mutex_unlock(&DaemonLock);
+	DaemonRequest(pW, Req);
+	}
+return(NULL);
+}
+
+
+// *******************************************************************
+// We read one request from the client, run it with the report going
+// to the client, and end the reply with the request's status and
+// latency.  We return 1 if the request succeeded.
+// *******************************************************************
+static int DaemonRequest(struct DAEMONWORKER *pW, struct DAEMONREQ Req)
+{
+FILE *			fpIn;
+FILE *			fpOut;
+char			sLine[TUR_BATCH_LINE_MAX];
+struct TURING	Job;
+struct timespec	Start, End;
+double			Wait, Latency;
+uint64_t		Id;
+int				fd, Bucket, Ok = 0;
+
+clock_gettime(CLOCK_MONOTONIC, &Start);
+Wait = DaemonSeconds(&Req.Arrived, &Start);
+if((fd = dup(Req.fd)) < 0 || (fpIn = fdopen(Req.fd, "r")) == NULL) {
+	if(fd >= 0) {
+		close(fd);
+		}
+	close(Req.fd);
+	return(0);
+	}
+if((fpOut = fdopen(fd, "w")) == NULL) {
+	close(fd);
+	fclose(fpIn);
+	return(0);
+	}
+
+pthread_mutex_lock(&DaemonLock);
+Id = ++Requests;
+pthread_mutex_unlock(&DaemonLock);
+
+if(fgets(sLine, sizeof(sLine), fpIn) == NULL) {
+	fprintf(fpOut, "Request %ju: no request received \n", (uintmax_t) Id);
+	}
+else if(strncmp(sLine, "stats", 5) == 0 && (sLine[5] == '\0' || isspace((unsigned char) sLine[5]))) {
+	Ok = DaemonReport(fpOut);
+	}
+else {
+	Job = pW->tur;
+	if(DaemonLine(sLine, &Job) < 1) {
+		fprintf(fpOut, "Invalid request: the parameters are -t or -n (required), -T or -G, "
+			"and -g -c -p -a -Z -v -m -E -q -R \n");
+		}
+	else {
+		pW->ctx->fpOut = fpOut;
+		Ok = TuringJob(pW->ctx, Job);
+		pW->ctx->fpOut = stdout;
+		}
+	}
+
+clock_gettime(CLOCK_MONOTONIC, &End);
+Latency = DaemonSeconds(&Req.Arrived, &End);
+fprintf(fpOut, "Request %ju: %s, waited %.6f seconds, latency %.6f seconds \n", (uintmax_t) Id,
+	Ok == 1 ? "done" : "failed", Wait, Latency);
+fclose(fpOut);
+fclose(fpIn);
+
+Bucket = Latency > 1e-9 ? (int) (4 * log2(Latency * 1e9)) : 0;
+Bucket = Bucket < TUR_STATS_BUCKETS ? Bucket : TUR_STATS_BUCKETS - 1;
+pthread_mutex_lock(&DaemonLock);
+Answered++;
+Failed += Ok == 1 ? 0 : 1;
+WaitSum += Wait;
+LatencySum += Latency;
+LatencyMax = Latency > LatencyMax ? Latency : LatencyMax;
+Hist[Bucket]++;
+pthread_mutex_unlock(&DaemonLock);
+return(Ok);
+}
+
+
+// *******************************************************************
+// We parse one request into pJob (which starts as a copy of the
+// server's parameters).  The request's parameters are those of the
+// command line that apply to one job; the others (-b, -k, -w, -H,
+// -I and so on) are the server's.  We return -1 for an invalid
+// request, and 1 otherwise.
+// *******************************************************************
+static int DaemonLine(char *sLine, struct TURING *pJob)
+{
+char	*sToken, *sValue, *pSave;
+int		tDecimalDigits = -1;
+
+pJob->tBuf[0] = '\0';
+pJob->TBuf[0] = '\0';
+pJob->SweepGram = 0;
+pJob->StartN = 0;
+for(sToken = strtok_r(sLine, " \t\r\n", &pSave); sToken != NULL;
+		sToken = strtok_r(NULL, " \t\r\n", &pSave)) {
+	if(strlen(sToken) != 2 || sToken[0] != '-') {
+		return(-1);
+		}
+	switch(sToken[1]) {
+		case 'v':
+			pJob->Verbose = true;
+			continue;
+		case 'm':
+			pJob->Mixed = true;
+			continue;
+		case 'E':
+			pJob->Grid = true;
+			pJob->Mixed = true;
+			continue;
+		case 'q':
+			pJob->Classify = true;
+			continue;
+		case 'R':
+			pJob->Rosser = true;
+			continue;
+		}
+	if((sValue = strtok_r(NULL, " \t\r\n", &pSave)) == NULL) {
+		return(-1);
+		}
+	switch(sToken[1]) {
+		case 't':
+		case 'T':
+			if(strlen(sValue) >= HGT_MAX_CMDLINE_STRLEN || ValidateHardyT(sValue) < 1) {
+				return(-1);
+				}
+			strcpy(sToken[1] == 't' ? pJob->tBuf : pJob->TBuf, sValue);
+			if(sToken[1] == 't') {
+				tDecimalDigits = GetDecimalDigits(pJob->tBuf);
+				}
+			break;
+		case 'G':
+			if((pJob->SweepGram = ValidateSweepCount(sValue)) < 1) {
+				return(-1);
+				}
+			break;
+		case 'n':
+			if((pJob->StartN = ValidateSweepCount(sValue)) < 1) {
+				return(-1);
+				}
+			break;
+		case 'g':
+			pJob->CountGram = ValidateTuringGramPoints(sValue);
+			break;
+		case 'c':
+			pJob->CountZ = ValidateTuringSubIntervals(sValue);
+			break;
+		case 'p':
+			pJob->OutputDP = ValidateReportDecimalPlaces(sValue);
+			break;
+		case 'a':
+			pJob->Refine = ValidateRange(sValue, 1, TUR_REFINE_MAX);
+			break;
+		case 'Z':
+			pJob->ZeroDigits = ValidateRange(sValue, 1, TUR_ZERO_DIGITS_MAX);
+			break;
+		default:
+			return(-1);
+		}
+	if(pJob->CountGram < 1 || pJob->CountZ < 1 || pJob->OutputDP < 1
+		|| pJob->Refine < 0 || pJob->ZeroDigits < 0) {
+		return(-1);
+		}
+	}
+
+// -------------------------------------------------------------------
+// The same checks as the command line.
+// -------------------------------------------------------------------
+if((tDecimalDigits == -1) == (pJob->StartN == 0)
+	|| (pJob->TBuf[0] != '\0' && pJob->SweepGram > 0)) {
+	return(-1);
+	}
+if(pJob->StartN > 0) {
+	snprintf(pJob->tBuf, sizeof(pJob->tBuf), "%.6f", GramApprox(pJob->StartN));
+	}
+else if(tDecimalDigits > pJob->OutputDP) {
+	pJob->OutputDP = tDecimalDigits;
+	}
+if(pJob->TBuf[0] != '\0' && strtod(pJob->TBuf, NULL) < strtod(pJob->tBuf, NULL)) {
+	return(-1);
+	}
+if(pJob->ZeroDigits > ZeroDigitsMax(pJob->DefaultBits, AutoEnd(*pJob))) {
+	return(-1);
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// We print the request statistics so far.
+// *******************************************************************
+static int DaemonReport(FILE *fp)
+{
+pthread_mutex_lock(&DaemonLock);
+fprintf(fp, "Requests = %ju answered (%ju failed), %ju running, %d waiting, %ju turned away; "
+	"latency (seconds): mean = %.6f, p50 = %.6f, p99 = %.6f, max = %.6f, mean wait = %.6f \n",
+	(uintmax_t) Answered, (uintmax_t) Failed, (uintmax_t) (Requests - Answered), QueueCount,
+	(uintmax_t) Rejected, Answered > 0 ? LatencySum / Answered : 0, DaemonPercentile(0.50),
+	DaemonPercentile(0.99), LatencyMax, Answered > 0 ? WaitSum / Answered : 0);
+pthread_mutex_unlock(&DaemonLock);
+fflush(fp);
+return(1);
+}
+
+
+// *******************************************************************
+// A latency percentile, from the histogram: the top of the bucket
+// holding it (but no more than the largest latency seen).  The caller
+// holds DaemonLock.
+// *******************************************************************
+static double DaemonPercentile(double Fraction)
+{
+uint64_t	Count = 0, Sum = 0;
+double		Top;
+int			i;
+
+for(i=0; i < TUR_STATS_BUCKETS; i++) {
+	Count += Hist[i];
+	}
+for(i=0; i < TUR_STATS_BUCKETS; i++) {
+	Sum += Hist[i];
+	if(Sum > 0 && Sum >= (uint64_t) ceil(Fraction * (double) Count)) {
+		Top = pow(2, (i + 1) / 4.0) * 1e-9;
+		return(Top < LatencyMax ? Top : LatencyMax);
+		}
+	}
+return(LatencyMax);
+}
+
+
+static double DaemonSeconds(struct timespec *pStart, struct timespec *pEnd)
+{
+return((double) (pEnd->tv_sec - pStart->tv_sec)
+	+ ((double) (pEnd->tv_nsec - pStart->tv_nsec) / 1000000000.0));
+}
+
+
+static void DaemonSignal(int Signal)
+{
+(void) Signal;
+DaemonStop = 1;
+}
+#endif
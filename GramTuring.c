@@ -0,0 +1,172 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+
+extern struct	HGT_INIT	hgt_init;
+
+static int		GramTheta(mpfr_t Theta, mpfr_t dTheta, mpfr_t t);
+
+
+// *******************************************************************
+// We locate the Gram point g(n) given the previous Gram point g(n-1),
+// so that we do not need to solve theta(g) = n * pi from scratch (as
+// GramAtN does).
+// *******************************************************************
+int GramNext(mpfr_t *Gram, mpfr_t Prev, mpfr_t n, mpfr_t Accuracy)
+{
+return(GramFrom(Gram, Prev, 1, n, Accuracy));
+}
+
+
+// *******************************************************************
+// We locate the Gram point g(n) given a nearby Gram point, Prev =
+// g(n - Steps).  Steps may be negative, or 0 (which refines Prev).
+//
+// Consecutive Gram points are about 2 pi / log(t / 2 pi) apart.  Using
+// theta'(t) = (1/2) log(t / 2 pi) at the midpoint of the step, our
+// first guess (for Steps = 1) is typically within 1e-5 of g(n), and
+// one or two Newton steps on theta(g) - n * pi bring us within
+// Accuracy.  We then take one more step, so our result is well inside
+// Accuracy.  For a longer step (from a -I index entry), the guess is
+// not as good, but theta is so nearly linear that Newton still
+// converges in a few steps.
+//
+// For small t (where the asymptotic series for theta is not good
+// enough) or if Newton fails to converge, we fall back to GramAtN.
+// *******************************************************************
+int GramFrom(mpfr_t *Gram, mpfr_t Prev, int64_t Steps, mpfr_t n, mpfr_t Accuracy)
+{
+mpfr_t	g, Theta, dTheta, nPi, Delta;
+double	dPrev, dStep;
+int		i, Done;
+
+if(mpfr_cmp_ui (Prev, TUR_GRAM_NEXT_MIN) < 0) {
+	return(GramAtN(Gram, n, Accuracy));
+	}
+
+mpfr_inits2 (hgt_init.DefaultBits, g, Theta, dTheta, nPi, Delta, (mpfr_ptr) 0);
+
+// -------------------------------------------------------------------
+// First guess: g(n - Steps) + Steps * pi / theta'(midpoint), where the
+// midpoint is itself estimated with theta'(g(n - Steps)).  A double is
+// enough here.
+// -------------------------------------------------------------------
+dPrev = mpfr_get_d (Prev, MPFR_RNDN);
+dStep = (double) Steps * 2 * M_PI / log(dPrev / (2 * M_PI));
+dStep = (double) Steps * 2 * M_PI / log((dPrev + (dStep / 2)) / (2 * M_PI));
+mpfr_add_d (g, Prev, dStep, MPFR_RNDN);
+
+mpfr_const_pi (nPi, MPFR_RNDN);
+mpfr_mul (nPi, nPi, n, MPFR_RNDN);
+
+// -------------------------------------------------------------------
+// Newton steps on theta(g) - n * pi.  Done counts the steps taken
+// after |Delta| < Accuracy (we take just one).
+// -------------------------------------------------------------------
+Done = 0;
+for(i=0; i < TUR_GRAM_NEXT_STEPS && Done < 2; i++) {
+	GramTheta(Theta, dTheta, g);
+	mpfr_sub (Delta, Theta, nPi, MPFR_RNDN);
+	mpfr_div (Delta, Delta, dTheta, MPFR_RNDN);
+	mpfr_sub (g, g, Delta, MPFR_RNDN);
+	mpfr_abs (Delta, Delta, MPFR_RNDN);
+	if(Done > 0 || mpfr_cmp (Delta, Accuracy) < 0) {
+		Done++;
+		}
+	}
+
+if(Done == 0) {
+	GramAtN(Gram, n, Accuracy);
+	}
+else {
+	mpfr_set (*Gram, g, MPFR_RNDN);
+	}
+mpfr_clears (g, Theta, dTheta, nPi, Delta, (mpfr_ptr) 0);
+return(1);
+}
+
+
+// *******************************************************************
+// We set the Accuracy every Gram point is located to: 0.5e-16 (that
+// is, 0.5 * 10^-TUR_GRAM_DIGITS).
+// *******************************************************************
+int GramAccuracy(mpfr_t Accuracy)
+{
+mpfr_set_str (Accuracy, "0.1", 10, MPFR_RNDN);
+mpfr_pow_ui(Accuracy, Accuracy, TUR_GRAM_DIGITS, MPFR_RNDN);
+mpfr_div_ui(Accuracy, Accuracy, 2, MPFR_RNDN);
+return(1);
+}
+
+
+// *******************************************************************
+// We compute the Riemann-Siegel theta function and its derivative
+// from the asymptotic series:
+//
+// theta(t) = (t/2) log(t / 2 pi) - t/2 - pi/8 + 1/(48t) + 7/(5760t^3)
+//            + 31/(80640t^5) + 127/(430080t^7) + ...
+//
+// theta'(t) = (1/2) log(t / 2 pi) - 1/(48t^2) - ...
+//
+// (Newton needs only a good theta'(t), so we stop at the 1/t^2 term).
+//
+// The first omitted term of theta is 511/(1216512t^9): about 4.2e-22
+// at t = TUR_GRAM_NEXT_MIN (100), and below 1e-24 from t = 196 on, well
+// inside the Accuracy we need for Gram points.
+// *******************************************************************
+static int GramTheta(mpfr_t Theta, mpfr_t dTheta, mpfr_t t)
+{
+mpfr_t	Pi, LogT, Temp1, Temp2;
+
+mpfr_inits2 (hgt_init.DefaultBits, Pi, LogT, Temp1, Temp2, (mpfr_ptr) 0);
+mpfr_const_pi (Pi, MPFR_RNDN);
+
+mpfr_mul_ui (LogT, Pi, 2, MPFR_RNDN);
+mpfr_div (LogT, t, LogT, MPFR_RNDN);
+mpfr_log (LogT, LogT, MPFR_RNDN);					// log(t / 2 pi)
+
+mpfr_sub_ui (Theta, LogT, 1, MPFR_RNDN);
+mpfr_mul (Theta, Theta, t, MPFR_RNDN);
+mpfr_div_ui (Theta, Theta, 2, MPFR_RNDN);			// (t/2)(log(t / 2 pi) - 1)
+mpfr_div_ui (Temp1, Pi, 8, MPFR_RNDN);
+mpfr_sub (Theta, Theta, Temp1, MPFR_RNDN);			// - pi/8
+
+mpfr_ui_div (Temp1, 1, t, MPFR_RNDN);				// 1/t
+mpfr_div_ui (Temp2, Temp1, 48, MPFR_RNDN);
+mpfr_add (Theta, Theta, Temp2, MPFR_RNDN);			// + 1/(48t)
+mpfr_pow_ui (Temp2, Temp1, 3, MPFR_RNDN);
+mpfr_mul_ui (Temp2, Temp2, 7, MPFR_RNDN);
+mpfr_div_ui (Temp2, Temp2, 5760, MPFR_RNDN);
+mpfr_add (Theta, Theta, Temp2, MPFR_RNDN);			// + 7/(5760t^3)
+mpfr_pow_ui (Temp2, Temp1, 5, MPFR_RNDN);
+mpfr_mul_ui (Temp2, Temp2, 31, MPFR_RNDN);
+mpfr_div_ui (Temp2, Temp2, 80640, MPFR_RNDN);
+mpfr_add (Theta, Theta, Temp2, MPFR_RNDN);			// + 31/(80640t^5)
+mpfr_pow_ui (Temp2, Temp1, 7, MPFR_RNDN);
+mpfr_mul_ui (Temp2, Temp2, 127, MPFR_RNDN);
+mpfr_div_ui (Temp2, Temp2, 430080, MPFR_RNDN);
+mpfr_add (Theta, Theta, Temp2, MPFR_RNDN);			// + 127/(430080t^7)
+
+mpfr_div_ui (dTheta, LogT, 2, MPFR_RNDN);			// (1/2) log(t / 2 pi)
+mpfr_sqr (Temp2, Temp1, MPFR_RNDN);
+mpfr_div_ui (Temp2, Temp2, 48, MPFR_RNDN);
+mpfr_sub (dTheta, dTheta, Temp2, MPFR_RNDN);		// - 1/(48t^2)
+
+mpfr_clears (Pi, LogT, Temp1, Temp2, (mpfr_ptr) 0);
+return(1);
+}
@@ -0,0 +1,184 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <float.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+
+extern struct	HGT_INIT	hgt_init;
+
+
+// *******************************************************************
+// With -E (the grid engine), the CountZ samples of a Gram interval
+// are computed together, in double precision, as one evenly spaced
+// grid t0, t0 + h, ..., t0 + (Count - 1) h (see GridHardyZ).  As with
+// -m, any value whose sign the error bound cannot certify is then
+// re-computed with MPFR.  We return the number of values re-computed,
+// and keep the largest error bound in gList[i].GridBound.  We return
+// -1 (having computed nothing) if the grid cannot be used here, and
+// MixedInterval then goes one point at a time.
+// *******************************************************************
+int GridInterval(struct TURCTX *ctx, struct TURING tur, int i)
+{
+double *	Z;
+double *	Bound;
+mpfr_t		t, One;
+int			j, idx, Escalated = 0;
+
+ctx->gList[i].GridBound = 0;
+if((Z = malloc(2 * (size_t) tur.CountZ * sizeof(double))) == NULL) {
+	return(-1);
+	}
+Bound = Z + tur.CountZ;
+if(GridHardyZ(mpfr_get_d (ctx->gList[i].Gram, MPFR_RNDN),
+	mpfr_get_d (ctx->gList[i].lenSubInterval, MPFR_RNDN), tur.CountZ, Z, Bound) == 0) {
+	free(Z);
+	return(-1);
+	}
+
+mpfr_inits2 (hgt_init.DefaultBits, t, One, (mpfr_ptr) 0);
+mpfr_set_ui(One, 1, MPFR_RNDN);
+idx = (i * ctx->CountZ) + 1;
+for(j = 0; j < tur.CountZ; j++) {
+	if(fabs(Z[j]) > Bound[j]) {
+		ctx->hInfo[idx + j].hzValue = Z[j];
+		ctx->gList[i].GridBound = Bound[j] > ctx->gList[i].GridBound
+			? Bound[j] : ctx->gList[i].GridBound;
+		continue;
+		}
+	HardyT(ctx, t, tur, idx + j);
+	TimedHardyZ(t, One, 1, TUR_CALLER(ctx, idx + j), HardyZCallbackC);
+	Escalated++;
+	}
+mpfr_clears (t, One, (mpfr_ptr) 0);
+free(Z);
+return(Escalated);
+}
+
+
+// *******************************************************************
+// We compute Hardy Z, with an error bound, at t_k = t0 + k h for k = 0
+// through Count - 1, by the same Riemann-Siegel formula as
+// HardyZDouble.  There, each term of the main sum costs a log, a
+// square root and a cosine at each point.  Here, each term
+//
+//     e^{-i t_k log n} / sqrt(n)
+//
+// is set up once, at t0, and then carried to the next point by one
+// complex multiplication by the fixed rotation e^{-i h log n}.  The
+// main sum at t_k is then 2 Re(e^{i theta(t_k)} sum_n (term n)).
+//
+// The bound is that of HardyZDouble, plus the error the rotations
+// build up: each step adds a few units in the last place to the phase
+// and size of each term (and h log n is itself rounded), so after k
+// steps a term may be off by (k + 1)(h log N + 8) DBL_EPSILON.  The
+// points with p too close to 1/4 or 3/4 get a bound of DBL_MAX.
+//
+// We return 0 (and compute nothing) below TUR_MIXED_MIN, or if the
+// sum would need more than TUR_GRID_TERMS_MAX terms, where the
+// caller should go one point at a time.
+// *******************************************************************
+int GridHardyZ(double t0, double h, int Count, double *Z, double *Bound)
+{
+double *	Term;
+double		t, Tau, LogTau, a, p, C0Den, Theta, Re, Im, rRe, rIm, Log, Weight, Total;
+double		ePhase, eSum, eT, eGrid;
+long		n, N, Na, Nk;
+int			k;
+
+if(t0 < TUR_MIXED_MIN) {
+	return(0);
+	}
+N = MixedTerms((t0 + ((Count - 1) * h)) / (2 * M_PI));
+if(N > TUR_GRID_TERMS_MAX) {
+	return(0);
+	}
+
+// -------------------------------------------------------------------
+// Term holds four doubles for each n: the term (Re, Im) at the
+// current point, and its rotation (Re, Im).
+// -------------------------------------------------------------------
+if((Term = malloc(4 * (size_t) (N + 1) * sizeof(double))) == NULL) {
+	return(0);
+	}
+for(n = 1; n <= N; n++) {
+	Log = log((double) n);
+	a = 1 / sqrt((double) n);
+	Term[4 * n]		= a * cos(t0 * Log);
+	Term[4 * n + 1]	= -a * sin(t0 * Log);
+	Term[4 * n + 2]	= cos(h * Log);
+	Term[4 * n + 3]	= -sin(h * Log);
+	}
+
+Weight = 0;
+Nk = 0;
+for(k = 0; k < Count; k++) {
+	t		= t0 + (k * h);
+	Tau		= t / (2 * M_PI);
+	LogTau	= log(Tau);
+	a		= sqrt(Tau);
+	Na		= MixedTerms(Tau);
+	p		= a - (double) Na;
+	C0Den	= cos(2 * M_PI * p);
+	Theta	= (t / 2) * (LogTau - 1) - (M_PI / 8) + 1 / (48 * t) + 7 / (5760 * t * t * t);
+
+	// -------------------------------------------------------------------
+	// The weight sum_{n <= N} 1 / sqrt(n) (for the bound) only grows
+	// from one point to the next, as N does.
+	// -------------------------------------------------------------------
+	for(; Nk < Na && Nk < N; Nk++) {
+		Weight += 1 / sqrt((double) (Nk + 1));
+		}
+
+	Re = 0;
+	Im = 0;
+	for(n = 1; n <= Nk; n++) {
+		Re += Term[4 * n];
+		Im += Term[4 * n + 1];
+		}
+	if(fabs(C0Den) < TUR_MIXED_C0_MIN) {
+		Z[k] = 0;
+		Bound[k] = DBL_MAX;
+		}
+	else {
+		Total = 2 * ((cos(Theta) * Re) - (sin(Theta) * Im));
+		Z[k] = Total + ((Nk - 1) % 2 == 0 ? 1 : -1) * pow(Tau, -0.25)
+			* cos(2 * M_PI * ((p * p) - p - (1.0 / 16))) / C0Den;
+
+		ePhase	= 8 * DBL_EPSILON * t * (LogTau + 1);
+		eSum	= 2 * Weight * (ePhase + ((double) (Nk + 4) * DBL_EPSILON));
+		eT		= DBL_EPSILON * t * 4 * Weight * (LogTau + 1);
+		eGrid	= 2 * Weight * (k + 1) * ((h * log((double) N + 1)) + 8) * DBL_EPSILON;
+		Bound[k] = 2 * ((0.127 * pow(Tau, -0.75)) + eSum + eT + eGrid);
+		}
+
+	// -------------------------------------------------------------------
+	// Carry each term on to the next point.
+	// -------------------------------------------------------------------
+	if(k + 1 < Count) {
+		for(n = 1; n <= N; n++) {
+			Re = Term[4 * n];
+			Im = Term[4 * n + 1];
+			rRe = Term[4 * n + 2];
+			rIm = Term[4 * n + 3];
+			Term[4 * n]		= (Re * rRe) - (Im * rIm);
+			Term[4 * n + 1]	= (Re * rIm) + (Im * rRe);
+			}
+		}
+	}
+free(Term);
+return(1);
+}
@@ -0,0 +1,370 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <float.h>
+#include <pthread.h>
+#include <mpfr.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "hgt.h"
+#include "turing.h"
+#include "turindex.h"
+
+extern struct	HGT_INIT	hgt_init;
+
+static const char *					pMap = NULL;	// the whole file (mapped, or read on Windows)
+static size_t						MapSize = 0;
+static const struct TURIDXHEADER *	pHeader = NULL;
+static const struct TURIDXRECORD *	pRec = NULL;	// NULL: no index in use
+
+static int			IndexEntry(uint64_t ui64N);
+
+
+// *******************************************************************
+// With -I (and no -X), we map the Gram point index and check that it
+// was built the way this run locates Gram points: with the same bits,
+// and to the same Accuracy.  We return 0 (after printing why) if the
+// index cannot be used, and the run then goes on without it.  Once
+// open, the index is only read, so the -w workers and the -f jobs
+// share it without a lock.
+// *******************************************************************
+int IndexOpen(struct TURING tur)
+{
+FILE *		fp;
+uint64_t	Size;
+
+if((fp = fopen(tur.IndexFile, "rb")) == NULL) {
+	fprintf(stderr, "Unable to open Gram index %s \n", tur.IndexFile);
+	return(0);
+	}
+fseek(fp, 0, SEEK_END);
+Size = (uint64_t) ftell(fp);
+if(Size < sizeof(struct TURIDXHEADER)) {
+	fprintf(stderr, "The file %s is not a version %d Gram index \n", tur.IndexFile, TURIDX_VERSION);
+	fclose(fp);
+	return(0);
+	}
+
+#ifdef _WIN32
+char *	pRead;
+
+fseek(fp, 0, SEEK_SET);
+if((pRead = malloc((size_t) Size)) != NULL && fread(pRead, (size_t) Size, 1, fp) != 1) {
+	free(pRead);
+	pRead = NULL;
+	}
+pMap = pRead;
+#else
+pMap = mmap(NULL, (size_t) Size, PROT_READ, MAP_SHARED, fileno(fp), 0);
+if(pMap == MAP_FAILED) {
+	pMap = NULL;
+	}
+#endif
+fclose(fp);
+if(pMap == NULL) {
+	fprintf(stderr, "Unable to read Gram index %s \n", tur.IndexFile);
+	return(0);
+	}
+MapSize = (size_t) Size;
+pHeader = (const struct TURIDXHEADER *) pMap;
+
+if(memcmp(pHeader->Magic, TURIDX_MAGIC, sizeof(pHeader->Magic)) != 0
+	|| pHeader->Version != TURIDX_VERSION
+	|| pHeader->HeaderSize != sizeof(struct TURIDXHEADER)
+	|| pHeader->RecordSize != sizeof(struct TURIDXRECORD)
+	|| pHeader->Count == 0 || pHeader->Stride == 0
+	|| pHeader->Count > (Size - sizeof(struct TURIDXHEADER)) / sizeof(struct TURIDXRECORD)) {
+	fprintf(stderr, "The file %s is not a version %d Gram index \n", tur.IndexFile, TURIDX_VERSION);
+	IndexClose();
+	return(0);
+	}
+if(pHeader->Bits != (uint32_t) tur.DefaultBits || pHeader->Digits != TUR_GRAM_DIGITS) {
+	fprintf(stderr, "Gram index %s was built with %u bits to 0.5e-%u, not %d bits to 0.5e-%d, so is not used \n",
+		tur.IndexFile, pHeader->Bits, pHeader->Digits, tur.DefaultBits, TUR_GRAM_DIGITS);
+	IndexClose();
+	return(0);
+	}
+pRec = (const struct TURIDXRECORD *) (pMap + sizeof(struct TURIDXHEADER));
+return(1);
+}
+
+
+// *******************************************************************
+// We unmap (or free) the Gram point index, if open.
+// *******************************************************************
+int IndexClose(void)
+{
+if(pMap != NULL) {
+#ifdef _WIN32
+	free((void *) pMap);
+#else
+	munmap((void *) pMap, MapSize);
+#endif
+	}
+pMap = NULL;
+MapSize = 0;
+pHeader = NULL;
+pRec = NULL;
+return(1);
+}
+
+
+// *******************************************************************
+// With an index, we find the 'n' of the Gram point at or before 't'
+// (as GramNearT does) from the entry at or before 't', found by a
+// binary search.  'n' is that entry's n plus the whole number of pi
+// that theta gains from its Gram point g to 't'.  As theta(g) is
+// exactly n pi, only the gain is needed, not theta(t) itself, and as
+// the gain is small (about Stride pi), it is taken in double, from
+// d = t - g taken once in MPFR, with L = log(g / 2 pi):
+//
+// theta(g + d) - theta(g) = (d/2)(L - 1) + ((g + d)/2) log1p(d/g)
+//                           - d / (48 g (g + d))
+//
+// (the later terms of the series change by far less than the margin
+// below).  We return 0 if 't' is outside the index, or if the gain
+// over pi is too close to an integer to say which side of a Gram
+// point 't' is on; the caller then uses GramNearT.
+// *******************************************************************
+int IndexNearT(mpfr_t *n, mpfr_t t)
+{
+mpfr_t		Offset;
+double		dT, g, d, Gain, Margin;
+uint64_t	Lo, Hi, Mid, Whole;
+
+if(pRec == NULL) {
+	return(0);
+	}
+dT = mpfr_get_d (t, MPFR_RNDN);
+if(dT < pRec[0].dGram || dT >= pRec[pHeader->Count - 1].dGram
+	|| pRec[0].dGram < TUR_GRAM_NEXT_MIN) {
+	return(0);
+	}
+
+// -------------------------------------------------------------------
+// pRec[Lo].dGram <= dT < pRec[Hi].dGram.
+// -------------------------------------------------------------------
+Lo = 0;
+Hi = pHeader->Count - 1;
+while(Hi - Lo > 1) {
+	Mid = Lo + ((Hi - Lo) / 2);
+	if(pRec[Mid].dGram <= dT) {
+		Lo = Mid;
+		}
+	else {
+		Hi = Mid;
+		}
+	}
+
+mpfr_init2 (Offset, hgt_init.DefaultBits);
+if(mpfr_set_str (Offset, pRec[Lo].sGram, 10, MPFR_RNDN) != 0) {
+	mpfr_clear (Offset);
+	return(0);
+	}
+mpfr_sub (Offset, t, Offset, MPFR_RNDN);
+d = mpfr_get_d (Offset, MPFR_RNDN);
+mpfr_clear (Offset);
+
+g = pRec[Lo].dGram;
+Gain = ((d / 2) * (log(g / (2 * M_PI)) - 1)) + (((g + d) / 2) * log1p(d / g))
+	- (d / (48 * g * (g + d)));
+Gain /= M_PI;
+Margin = 64 * DBL_EPSILON * (Gain + 1);
+Margin = Margin > TUR_GRAM_NEAR_MARGIN ? Margin : TUR_GRAM_NEAR_MARGIN;
+if(Gain < 0 || Gain - floor(Gain) <= Margin || Gain - floor(Gain) >= 1 - Margin) {
+	return(0);
+	}
+Whole = (uint64_t) floor(Gain);
+if(pRec[Lo].n + Whole >= pRec[Hi].n) {
+	return(0);
+	}
+mpfr_set_uj (*n, pRec[Lo].n + Whole, MPFR_RNDN);
+return(1);
+}
+
+
+// *******************************************************************
+// With an index, we locate g(n) (the first Gram point of a run) from
+// the nearest entry, by GramFrom, rather than from scratch.  We return
+// 0 (having located nothing) if 'n' is outside the index, and the
+// caller then uses GramAtN.
+// *******************************************************************
+int IndexGram(struct TURCTX *ctx, mpfr_t *Gram, mpfr_t n, mpfr_t Accuracy)
+{
+mpfr_t		Prev;
+uint64_t	ui64N;
+int			k;
+
+if(pRec == NULL) {
+	return(0);
+	}
+ui64N = mpfr_get_uj (n, MPFR_RNDN);
+ctx->sweep.IndexTried = true;
+ctx->sweep.IndexN = ui64N;
+if((k = IndexEntry(ui64N)) < 0) {
+	return(0);
+	}
+
+mpfr_init2 (Prev, hgt_init.DefaultBits);
+if(mpfr_set_str (Prev, pRec[k].sGram, 10, MPFR_RNDN) != 0) {
+	mpfr_clear (Prev);
+	return(0);
+	}
+GramFrom(Gram, Prev, (int64_t) (ui64N - pRec[k].n), n, Accuracy);
+mpfr_clear (Prev);
+ctx->sweep.IndexUsed = true;
+ctx->sweep.IndexFrom = pRec[k].n;
+return(1);
+}
+
+
+// *******************************************************************
+// We return the index entry nearest g(n), or -1 if 'n' is outside the
+// index (or the entry is not the one expected).
+// *******************************************************************
+static int IndexEntry(uint64_t ui64N)
+{
+uint64_t	k;
+
+if(ui64N < pHeader->FirstN || ui64N > pHeader->FirstN + ((pHeader->Count - 1) * pHeader->Stride)) {
+	return(-1);
+	}
+k = (ui64N - pHeader->FirstN + (pHeader->Stride / 2)) / pHeader->Stride;
+k = k < pHeader->Count ? k : pHeader->Count - 1;
+if(k > INT32_MAX || pRec[k].n != pHeader->FirstN + (k * pHeader->Stride)) {
+	return(-1);
+	}
+return((int) k);
+}
+
+
+// *******************************************************************
+// We print how the first Gram point of the run was located.
+// *******************************************************************
+int IndexReport(struct TURCTX *ctx, struct TURING tur)
+{
+if(ctx->sweep.IndexUsed == true) {
+	fprintf(ctx->fpOut, "Gram index (%s): g(%ju) was located from the entry for g(%ju) \n", tur.IndexFile,
+		(uintmax_t) ctx->sweep.IndexN, (uintmax_t) ctx->sweep.IndexFrom);
+	}
+else if(ctx->sweep.IndexTried == true) {
+	fprintf(ctx->fpOut, "Gram index (%s): g(%ju) is not in the index, so was located from scratch \n",
+		tur.IndexFile, (uintmax_t) ctx->sweep.IndexN);
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// With -X, we build the Gram point index named by -I over the -T or
+// -G sweep (from -t or -n), with an entry every Stride Gram points.
+// The entries are at multiples of Stride, and run from the one at or
+// before the first Gram point of the sweep through the one at or
+// after its last.  Only the first entry is located from scratch; each
+// later one is located from its predecessor by GramFrom.
+// *******************************************************************
+int IndexBuild(struct TURING tur)
+{
+struct TURIDXHEADER	Header;
+struct TURIDXRECORD	Rec;
+mpfr_t				t, n, Accuracy, Gram, Prev;
+uint64_t			StartN, EndN, k;
+FILE *				fp;
+int					Result = 1;
+
+if(tur.TBuf[0] == '\0' && tur.SweepGram == 0) {
+	printf("The -X parameter requires -T or -G (the range to index).\n");
+	return(0);
+	}
+if(tur.IndexFile[0] == '\0') {
+	printf("The -X parameter requires -I (the index file to build).\n");
+	return(0);
+	}
+
+TuringOpen(tur);
+mpfr_inits2 (hgt_init.DefaultBits, t, n, Accuracy, Gram, Prev, (mpfr_ptr) 0);
+GramAccuracy(Accuracy);
+if(tur.StartN > 0) {
+	StartN = tur.StartN;
+	}
+else {
+	mpfr_set_str (t, tur.tBuf, 10, MPFR_RNDN);
+	GramNearT(&n, t);
+	StartN = mpfr_get_uj (n, MPFR_RNDN);
+	}
+EndN = StartN + tur.SweepGram;
+if(tur.TBuf[0] != '\0') {
+	mpfr_set_str (t, tur.TBuf, 10, MPFR_RNDN);
+	GramNearT(&n, t);
+	EndN = mpfr_get_uj (n, MPFR_RNDN) + 1;
+	}
+
+memset(&Header, 0, sizeof(Header));
+memcpy(Header.Magic, TURIDX_MAGIC, sizeof(Header.Magic));
+Header.Version = TURIDX_VERSION;
+Header.HeaderSize = sizeof(struct TURIDXHEADER);
+Header.RecordSize = sizeof(struct TURIDXRECORD);
+Header.Bits = (uint32_t) tur.DefaultBits;
+Header.Digits = TUR_GRAM_DIGITS;
+Header.Stride = tur.IndexStride;
+Header.FirstN = StartN - (StartN % tur.IndexStride);
+Header.FirstN = Header.FirstN > 0 ? Header.FirstN : tur.IndexStride;
+Header.Count = EndN > Header.FirstN
+	? ((EndN - Header.FirstN + tur.IndexStride - 1) / tur.IndexStride) + 1 : 1;
+
+if((fp = fopen(tur.IndexFile, "wb")) == NULL
+	|| fwrite(&Header, sizeof(Header), 1, fp) != 1) {
+	printf("Unable to write Gram index %s \n", tur.IndexFile);
+	Result = 0;
+	}
+
+StatsBegin(TUR_PHASE_GRAMPTS);
+for(k = 0; Result == 1 && k < Header.Count; k++) {
+	memset(&Rec, 0, sizeof(Rec));
+	Rec.n = Header.FirstN + (k * tur.IndexStride);
+	mpfr_set_uj (n, Rec.n, MPFR_RNDN);
+	if(k == 0) {
+		GramAtN(&Gram, n, Accuracy);
+		}
+	else {
+		GramFrom(&Gram, Prev, (int64_t) tur.IndexStride, n, Accuracy);
+		}
+	mpfr_set (Prev, Gram, MPFR_RNDN);
+	Rec.dGram = mpfr_get_d (Gram, MPFR_RNDN);
+	if(mpfr_snprintf(Rec.sGram, sizeof(Rec.sGram), "%.*Rf", TUR_GRAM_DIGITS + TURIDX_EXTRA_DIGITS, Gram)
+			>= (int) sizeof(Rec.sGram)
+		|| fwrite(&Rec, sizeof(Rec), 1, fp) != 1) {
+		printf("Unable to write Gram index %s (at n = %ju) \n", tur.IndexFile, (uintmax_t) Rec.n);
+		Result = 0;
+		}
+	}
+StatsEnd(TUR_PHASE_GRAMPTS);
+
+if(fp != NULL && fclose(fp) != 0) {
+	printf("Unable to write Gram index %s \n", tur.IndexFile);
+	Result = 0;
+	}
+if(Result == 1) {
+	printf("Gram index %s: %ju entries, g(n) for n = %ju through %ju in steps of %ju, %d bits \n",
+		tur.IndexFile, (uintmax_t) Header.Count, (uintmax_t) Header.FirstN,
+		(uintmax_t) (Header.FirstN + ((Header.Count - 1) * tur.IndexStride)),
+		(uintmax_t) tur.IndexStride, tur.DefaultBits);
+	}
+mpfr_clears (t, n, Accuracy, Gram, Prev, (mpfr_ptr) 0);
+TuringClose();
+return(Result);
+}
@@ -0,0 +1,165 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <float.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+
+extern struct	HGT_INIT	hgt_init;
+
+
+// *******************************************************************
+// With -m (mixed precision), we compute each Hardy Z value first in
+// double precision, with an error bound (see HardyZDouble).  Only if
+// |Z| is not safely larger than that bound -- so that we cannot be
+// sure of its sign -- do we re-compute the value with MPFR.  We
+// return the number of values re-computed with MPFR.
+//
+// NOTE: hInfo[idx].hzValue is then only as accurate as that bound, so
+// the digits shown in the report may differ slightly from a run
+// without -m.  The bound is an estimate with a margin, not a proof
+// (see HardyZDouble), so the signs are as safe as that margin.
+// *******************************************************************
+int MixedHardyZ(struct TURCTX *ctx, struct TURING tur, int idx)
+{
+mpfr_t	t, One;
+double	Z, Bound;
+int		Escalated = 0;
+
+mpfr_inits2 (hgt_init.DefaultBits, t, One, (mpfr_ptr) 0);
+HardyT(ctx, t, tur, idx);
+
+Z = HardyZDouble(mpfr_get_d (t, MPFR_RNDN), &Bound);
+if(fabs(Z) > Bound) {
+	ctx->hInfo[idx].hzValue = Z;
+	TextSample(ctx, idx, t);
+	}
+else {
+	mpfr_set_ui(One, 1, MPFR_RNDN);
+	TimedHardyZ(t, One, 1, TUR_CALLER(ctx, idx), HardyZCallbackC);
+	Escalated = 1;
+	}
+mpfr_clears (t, One, (mpfr_ptr) 0);
+return(Escalated);
+}
+
+
+// *******************************************************************
+// As MixedHardyZ, for all CountZ samples of Gram interval i (with -E,
+// all at once on the interval's grid where possible).
+// *******************************************************************
+int MixedInterval(struct TURCTX *ctx, struct TURING tur, int i)
+{
+int		j, Escalated = 0;
+
+if(tur.Grid == true && (Escalated = GridInterval(ctx, tur, i)) >= 0) {
+	return(Escalated);
+	}
+Escalated = 0;
+
+for(j = 0; j < tur.CountZ; j++) {
+	Escalated += MixedHardyZ(ctx, tur, (i * ctx->CountZ) + 1 + j);
+	}
+return(Escalated);
+}
+
+
+// *******************************************************************
+// We compute Hardy Z(t) in double precision by the Riemann-Siegel
+// formula, with the first (C0) correction term:
+//
+// Z(t) = 2 sum_{n=1}^{N} cos(theta(t) - t log n) / sqrt(n)
+//        + (-1)^(N-1) (t/2pi)^(-1/4) C0(p) + R,
+//
+// where N = floor(sqrt(t/2pi)), p = sqrt(t/2pi) - N and
+// C0(p) = cos(2pi(p^2 - p - 1/16)) / cos(2pi p).  The square root
+// may round up to N + 1 when t/2pi is just below (N + 1)^2, so N is
+// checked against t/2pi in exact integer terms.
+//
+// We set *pBound to an estimate of |Z(t) - our result|.  Only its
+// first part is proved: (1) Gabcke's bound |R| <= 0.127 (t/2pi)^(-3/4)
+// for t >= 200.  The rest are estimates: (2) the rounding error in the
+// phases theta(t) - t log n, a few units in the last place of t log t
+// (assuming log and cos are good to an ulp or so, as in glibc), (3)
+// the rounding error in the sum, and (4) the change in Z from t itself
+// being rounded to a double, taken from the derivative of the main sum
+// alone.  As (2) through (4) are not proved, the total is doubled as a
+// margin.  So a sign this deems safe is safe by that margin; it is not
+// certified.
+//
+// If t < TUR_MIXED_MIN, or p is too close to 1/4 or 3/4 (where C0 is
+// 0/0), we set *pBound to DBL_MAX so the caller will use MPFR.
+// *******************************************************************
+double HardyZDouble(double t, double *pBound)
+{
+double	Tau, a, p, LogTau, Theta, Sum, Weight, C0Den, Z;
+double	ePhase, eSum, eT;
+long	n, N;
+
+*pBound = DBL_MAX;
+if(t < TUR_MIXED_MIN) {
+	return(0);
+	}
+
+Tau		= t / (2 * M_PI);
+LogTau	= log(Tau);
+a		= sqrt(Tau);
+N		= MixedTerms(Tau);
+p		= a - (double) N;
+C0Den	= cos(2 * M_PI * p);
+if(fabs(C0Den) < TUR_MIXED_C0_MIN) {
+	return(0);
+	}
+
+Theta = (t / 2) * (LogTau - 1) - (M_PI / 8) + 1 / (48 * t) + 7 / (5760 * t * t * t);
+
+Sum = 0;
+Weight = 0;
+for(n = 1; n <= N; n++) {
+	Sum    += cos(Theta - (t * log((double) n))) / sqrt((double) n);
+	Weight += 1 / sqrt((double) n);
+	}
+Z = (2 * Sum) + ((N - 1) % 2 == 0 ? 1 : -1) * pow(Tau, -0.25)
+	* cos(2 * M_PI * ((p * p) - p - (1.0 / 16))) / C0Den;
+
+ePhase	= 8 * DBL_EPSILON * t * (LogTau + 1);
+eSum	= 2 * Weight * (ePhase + ((double) (N + 4) * DBL_EPSILON));
+eT		= DBL_EPSILON * t * 4 * Weight * (LogTau + 1);
+*pBound	= 2 * ((0.127 * pow(Tau, -0.75)) + eSum + eT);
+return(Z);
+}
+
+
+// *******************************************************************
+// We return N = floor(sqrt(Tau)), the number of terms of the main
+// sum.  (long) sqrt(Tau) alone can be one too many when Tau is just
+// below a perfect square (the square root rounds up to it), so we
+// make sure that N^2 <= Tau < (N + 1)^2.  N^2 is exact in a double
+// for any t we can reach.
+// *******************************************************************
+long MixedTerms(double Tau)
+{
+long	N;
+
+N = (long) sqrt(Tau);
+while(N > 0 && (double) N * (double) N > Tau) {
+	N--;
+	}
+while((double) (N + 1) * (double) (N + 1) <= Tau) {
+	N++;
+	}
+return(N);
+}
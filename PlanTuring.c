@@ -0,0 +1,360 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <time.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+
+extern struct	HGT_INIT	hgt_init;
+
+static const int	PlanBits[] = { 128, 256, 512, 1024 };
+static const int	PlanThreads[] = { 1, 2, 4, 8 };
+
+#define	TUR_PLAN_BITS		((int) (sizeof(PlanBits) / sizeof(PlanBits[0])))
+#define	TUR_PLAN_THREADS	((int) (sizeof(PlanThreads) / sizeof(PlanThreads[0])))
+#define	TUR_PLAN_EVALS		8		// Hardy Z values timed at each calibration point
+#define	TUR_PLAN_GRAMS		8		// GramNext steps timed
+#define	TUR_PLAN_REF_BITS	256		// the model's bits are relative to this
+#define	TUR_PLAN_T_MIN		100		// least 't' calibrated at
+
+// -------------------------------------------------------------------
+// The fitted cost model (see PlanRun).
+// -------------------------------------------------------------------
+struct TURPLAN {
+	double		A;					// seconds per evaluation, not growing with t
+	double		B;					// seconds per evaluation, per Riemann-Siegel term
+	double		Beta;				// cost grows as (bits / TUR_PLAN_REF_BITS)^Beta
+	double		Speedup[TUR_PLAN_THREADS];	// -k PlanThreads[j] speedup over -k 1
+	double		GramAt;				// seconds for GramAtN (the first Gram point)
+	double		GramNext;			// seconds for GramNext (each later one)
+	double		Terms;				// mean Riemann-Siegel terms over the range
+	uint64_t	Total;				// Gram intervals in the range
+};
+
+static double	PlanEval(char *sT, int Bits, int Threads, struct TURING tur);
+static int		PlanGram(char *sT, struct TURPLAN *pPlan, struct TURING tur);
+static double	PlanPredict(struct TURPLAN *pPlan, int Bits, int Threads, int Workers,
+					int CountGram, int CountZ);
+static int		PlanNoop(mpfr_t t, mpfr_t HardyZ, int i, int CallerID);
+static double	PlanSeconds(struct timespec *pStart, struct timespec *pEnd);
+
+
+// *******************************************************************
+// With -M, we predict how long the requested run will take on this
+// machine, and which settings would do it fastest, without doing it.
+//
+// A short calibration times HardyZWithCount at the end of the range
+// at each of the bits in PlanBits, at a smaller 't' (to separate the
+// cost of the Riemann-Siegel main sum, which has sqrt(t / 2 pi) terms,
+// from the rest), and at each -k thread count, along with GramAtN and
+// GramNext.  We fit
+//
+//   seconds per evaluation = (A + B sqrt(t / 2 pi))
+//                            * (bits / 256)^Beta / speedup(k)
+//
+// and price a run as its windows: each window locates its Gram points
+// one after another, and then its -w workers share out its Gram
+// intervals of CountZ evaluations each.
+//
+// The suggested -b is the least that -b auto deems safe for the range
+// (fewer bits are faster, but not safe).  -k and -w share out the
+// CPUs, and -g is raised if needed to keep every worker busy.  -c is
+// kept as given: it is the resolution asked for, and the prediction
+// for other -c values is shown.  -m, -E, -q and -a are not modelled.
+// *******************************************************************
+int PlanRun(struct TURING tur)
+{
+struct TURPLAN	Plan;
+mpfr_t			t, n;
+char			sHigh[HGT_MAX_CMDLINE_STRLEN + 2], sLow[HGT_MAX_CMDLINE_STRLEN + 2];
+double			tLow, tHigh, nLow, nHigh, Ref, Low, Each[TUR_PLAN_BITS];
+double			Sx, Sy, Sxx, Sxy, x, y, Seconds, Best;
+uint64_t		StartN;
+int				i, j, m, Cpus, Bits, Threads, Workers, CountGram;
+int				BestThreads = 1, BestWorkers = 1, BestGram = 1;
+
+// -------------------------------------------------------------------
+// The range, as -S finds it.
+// -------------------------------------------------------------------
+TuringOpen(tur);
+mpfr_inits2 (hgt_init.DefaultBits, t, n, (mpfr_ptr) 0);
+if(tur.StartN > 0) {
+	StartN = tur.StartN;
+	}
+else {
+	mpfr_set_str (t, tur.tBuf, 10, MPFR_RNDN);
+	GramNearT(&n, t);
+	StartN = mpfr_get_uj (n, MPFR_RNDN);
+	}
+Plan.Total = tur.SweepGram > 0 ? tur.SweepGram : (uint64_t) tur.CountGram;
+if(tur.TBuf[0] != '\0') {
+	mpfr_set_str (t, tur.TBuf, 10, MPFR_RNDN);
+	GramNearT(&n, t);
+	Plan.Total = mpfr_get_uj (n, MPFR_RNDN) - StartN + 1;
+	}
+mpfr_clears (t, n, (mpfr_ptr) 0);
+TuringClose();
+
+tLow = strtod(tur.tBuf, NULL);
+tHigh = tur.TBuf[0] != '\0' ? strtod(tur.TBuf, NULL) : GramApprox(StartN + Plan.Total);
+tHigh = tHigh > tLow ? tHigh : tLow;
+snprintf(sHigh, sizeof(sHigh), "%.6f", tHigh);
+
+// -------------------------------------------------------------------
+// The mean of sqrt(t / 2 pi) over the range.
+// -------------------------------------------------------------------
+if(tHigh - tLow > 1) {
+	Plan.Terms = (2.0 / 3.0) * (pow(tHigh, 1.5) - pow(tLow, 1.5)) / (tHigh - tLow) / sqrt(2 * M_PI);
+	}
+else {
+	Plan.Terms = sqrt(tHigh / (2 * M_PI));
+	}
+
+// -------------------------------------------------------------------
+// Calibrate.
+// -------------------------------------------------------------------
+Cpus = CpuCount();
+printf("Plan: Gram intervals n = %ju through %ju (%ju intervals), t = %s through %s, on %d CPUs \n",
+	(uintmax_t) StartN, (uintmax_t) (StartN + Plan.Total - 1), (uintmax_t) Plan.Total,
+	tur.tBuf, sHigh, Cpus);
+printf("\nCalibration at t = %s (seconds per Hardy Z evaluation, -k 1): \n", sHigh);
+for(i = 0; i < TUR_PLAN_BITS; i++) {
+	Each[i] = PlanEval(sHigh, PlanBits[i], 1, tur);
+	printf("    -b %4d  %.6f \n", PlanBits[i], Each[i]);
+	}
+Ref = PlanEval(sHigh, TUR_PLAN_REF_BITS, 1, tur);
+
+snprintf(sLow, sizeof(sLow), "%.6f", tHigh / 16 > TUR_PLAN_T_MIN ? tHigh / 16 : TUR_PLAN_T_MIN);
+nHigh = sqrt(tHigh / (2 * M_PI));
+nLow = sqrt(strtod(sLow, NULL) / (2 * M_PI));
+Low = PlanEval(sLow, TUR_PLAN_REF_BITS, 1, tur);
+printf("    -b %4d  %.6f at t = %s \n", TUR_PLAN_REF_BITS, Low, sLow);
+
+printf("Thread speedup (-k, at -b %d): ", TUR_PLAN_REF_BITS);
+for(j = 0; j < TUR_PLAN_THREADS; j++) {
+	Plan.Speedup[j] = 1;
+	if(PlanThreads[j] > 1 && PlanThreads[j] <= Cpus && PlanThreads[j] <= TUR_THREADS_MAX) {
+		Plan.Speedup[j] = Ref / PlanEval(sHigh, TUR_PLAN_REF_BITS, PlanThreads[j], tur);
+		}
+	if(PlanThreads[j] <= Cpus) {
+		printf("%s%d: %.2f", j > 0 ? ", " : "", PlanThreads[j], Plan.Speedup[j]);
+		}
+	}
+printf(" \n");
+PlanGram(sHigh, &Plan, tur);
+printf("Gram points (at -b %d): GramAtN %.6f seconds, GramNext %.6f seconds \n",
+	TUR_PLAN_REF_BITS, Plan.GramAt, Plan.GramNext);
+
+// -------------------------------------------------------------------
+// Fit the model: A and B from the two 't' values, and Beta by least
+// squares on log(seconds) against log(bits).
+// -------------------------------------------------------------------
+Plan.B = nHigh - nLow > 1 ? (Ref - Low) / (nHigh - nLow) : 0;
+Plan.B = Plan.B > 0 ? Plan.B : 0;
+Plan.A = Ref - (Plan.B * nHigh);
+Plan.A = Plan.A > 0 ? Plan.A : 0;
+Sx = Sy = Sxx = Sxy = 0;
+for(i = 0; i < TUR_PLAN_BITS; i++) {
+	x = log((double) PlanBits[i] / TUR_PLAN_REF_BITS);
+	y = log(Each[i] / Ref);
+	Sx += x;
+	Sy += y;
+	Sxx += x * x;
+	Sxy += x * y;
+	}
+Plan.Beta = (Sxy - (Sx * Sy / TUR_PLAN_BITS)) / (Sxx - (Sx * Sx / TUR_PLAN_BITS));
+printf("\nModel: seconds per evaluation = (%.3e + %.3e sqrt(t / 2 pi)) (bits / %d)^%.2f / speedup(k) \n",
+	Plan.A, Plan.B, TUR_PLAN_REF_BITS, Plan.Beta);
+
+// -------------------------------------------------------------------
+// Price the run as requested, and each way of sharing out the CPUs.
+// -------------------------------------------------------------------
+Bits = AutoPrecision(tur.tBuf, tHigh);
+Seconds = PlanPredict(&Plan, tur.DefaultBits, tur.Threads, tur.Workers, tur.CountGram, tur.CountZ);
+printf("\nAs requested: -b %d -k %d -w %d -g %d -c %d: %ju Hardy Z evaluations, predicted %.1f seconds \n",
+	tur.DefaultBits, tur.Threads, tur.Workers, tur.CountGram, tur.CountZ,
+	(uintmax_t) ((Plan.Total * tur.CountZ) + 1), Seconds);
+if(tur.DefaultBits < Bits) {
+	printf("(-b %d is below the %d bits -b auto chooses for this range) \n", tur.DefaultBits, Bits);
+	}
+
+printf("\nAt -b %d (-b auto), using all %d CPUs: \n", Bits, Cpus);
+Best = -1;
+for(j = 0; j < TUR_PLAN_THREADS; j++) {
+	Threads = PlanThreads[j];
+	if(Threads > Cpus || Threads > TUR_THREADS_MAX) {
+		continue;
+		}
+	Workers = Cpus / Threads;
+	Workers = Workers < TUR_WORKERS_MAX ? Workers : TUR_WORKERS_MAX;
+	CountGram = tur.CountGram;
+	if(Workers > CountGram) {
+		CountGram = Workers < HGT_TUR_GRAM_PTS_MAX ? Workers : HGT_TUR_GRAM_PTS_MAX;
+		Workers = Workers < CountGram ? Workers : CountGram;
+		}
+	Seconds = PlanPredict(&Plan, Bits, Threads, Workers, CountGram, tur.CountZ);
+	printf("    -k %d -w %d -g %d: predicted %.1f seconds \n", Threads, Workers, CountGram, Seconds);
+	if(Best < 0 || Seconds < Best) {
+		Best = Seconds;
+		BestThreads = Threads;
+		BestWorkers = Workers;
+		BestGram = CountGram;
+		}
+	}
+
+printf("\nBy -c (at the settings below): ");
+for(m = 8; m <= HGT_TUR_SUBINTVL_MAX; m *= 4) {
+	printf("%s-c %d: %.1f seconds", m > 8 ? ", " : "", m,
+		PlanPredict(&Plan, Bits, BestThreads, BestWorkers, BestGram, m));
+	}
+printf(" \n");
+
+printf("\nSuggested (predicted %.1f seconds): \n", Best);
+if(tur.StartN > 0) {
+	printf("turing -n %ju -G %ju", (uintmax_t) StartN, (uintmax_t) Plan.Total);
+	}
+else if(tur.TBuf[0] != '\0') {
+	printf("turing -t %s -T %s", tur.tBuf, tur.TBuf);
+	}
+else if(tur.SweepGram > 0) {
+	printf("turing -t %s -G %ju", tur.tBuf, (uintmax_t) tur.SweepGram);
+	}
+else {
+	printf("turing -t %s", tur.tBuf);
+	}
+printf(" -g %d -c %d -b %d -k %d -w %d \n", BestGram, tur.CountZ, Bits, BestThreads, BestWorkers);
+return(1);
+}
+
+
+// *******************************************************************
+// We return the seconds per Hardy Z evaluation at sT, with MPFR and
+// the coefficients set up for Bits and Threads (and set back after).
+// The first evaluation is not timed.
+// *******************************************************************
+static double PlanEval(char *sT, int Bits, int Threads, struct TURING tur)
+{
+struct timespec	Start, End;
+mpfr_t			t, Incr;
+
+tur.DefaultBits = Bits;
+tur.Threads = Threads;
+InitMPFR(tur.DefaultBits, tur.Threads, tur.DebugFlags, true);
+InitCoeffMPFR(hgt_init.DefaultBits);
+mpfr_inits2 (hgt_init.DefaultBits, t, Incr, (mpfr_ptr) 0);
+mpfr_set_str (t, sT, 10, MPFR_RNDN);
+mpfr_set_d (Incr, 0.01, MPFR_RNDN);
+HardyZWithCount(t, Incr, 1, 0, PlanNoop);
+clock_gettime(CLOCK_MONOTONIC, &Start);
+HardyZWithCount(t, Incr, TUR_PLAN_EVALS, 0, PlanNoop);
+clock_gettime(CLOCK_MONOTONIC, &End);
+mpfr_clears (t, Incr, (mpfr_ptr) 0);
+CloseCoeffMPFR();
+CloseMPFR();
+return(PlanSeconds(&Start, &End) / TUR_PLAN_EVALS);
+}
+
+
+// *******************************************************************
+// We time GramAtN and GramNext at sT.
+// *******************************************************************
+static int PlanGram(char *sT, struct TURPLAN *pPlan, struct TURING tur)
+{
+struct timespec	Start, End;
+mpfr_t			t, n, Gram, Prev, Accuracy;
+int				i;
+
+InitMPFR(TUR_PLAN_REF_BITS, 1, tur.DebugFlags, true);
+InitCoeffMPFR(hgt_init.DefaultBits);
+mpfr_inits2 (hgt_init.DefaultBits, t, n, Gram, Prev, Accuracy, (mpfr_ptr) 0);
+GramAccuracy(Accuracy);
+mpfr_set_str (t, sT, 10, MPFR_RNDN);
+GramNearT(&n, t);
+
+clock_gettime(CLOCK_MONOTONIC, &Start);
+GramAtN(&Prev, n, Accuracy);
+clock_gettime(CLOCK_MONOTONIC, &End);
+pPlan->GramAt = PlanSeconds(&Start, &End);
+
+clock_gettime(CLOCK_MONOTONIC, &Start);
+for(i = 0; i < TUR_PLAN_GRAMS; i++) {
+	mpfr_add_ui (n, n, 1, MPFR_RNDN);
+	GramNext(&Gram, Prev, n, Accuracy);
+	mpfr_set (Prev, Gram, MPFR_RNDN);
+	}
+clock_gettime(CLOCK_MONOTONIC, &End);
+pPlan->GramNext = PlanSeconds(&Start, &End) / TUR_PLAN_GRAMS;
+
+mpfr_clears (t, n, Gram, Prev, Accuracy, (mpfr_ptr) 0);
+CloseCoeffMPFR();
+CloseMPFR();
+return(1);
+}
+
+
+// *******************************************************************
+// We return the predicted seconds for the range with these settings.
+// Each window locates its Gram points (the first by GramAtN, then by
+// GramNext), and then each of the Workers computes CountZ samples for
+// each of its share of the window's Gram intervals.  Threads beyond
+// the largest calibrated are taken at its speedup.
+// *******************************************************************
+static double PlanPredict(struct TURPLAN *pPlan, int Bits, int Threads, int Workers,
+	int CountGram, int CountZ)
+{
+double		Scale, Eval, Windows, Rounds;
+int			j, k;
+
+Scale = pow((double) Bits / TUR_PLAN_REF_BITS, pPlan->Beta);
+for(j = k = 0; j < TUR_PLAN_THREADS; j++) {
+	if(PlanThreads[j] <= Threads) {
+		k = j;
+		}
+	}
+Eval = (pPlan->A + (pPlan->B * pPlan->Terms)) * Scale / pPlan->Speedup[k];
+Workers = Workers < CountGram ? Workers : CountGram;
+Windows = ceil((double) pPlan->Total / CountGram);
+Rounds = ceil((double) CountGram / (Workers > 0 ? Workers : 1));
+return(Scale * pPlan->GramAt
+	+ Windows * ((CountGram * Scale * pPlan->GramNext) + (Rounds * CountZ * Eval))
+	+ Eval);
+}
+
+
+// *******************************************************************
+// The calibration has no use for the values.
+// *******************************************************************
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+static int PlanNoop(mpfr_t t, mpfr_t HardyZ, int i, int CallerID)
+{
+return(1);
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+#pragma GCC diagnostic pop
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+
+static double PlanSeconds(struct timespec *pStart, struct timespec *pEnd)
+{
+return((double) (pEnd->tv_sec - pStart->tv_sec)
+	+ ((double) (pEnd->tv_nsec - pStart->tv_nsec) / 1000000000.0));
+}
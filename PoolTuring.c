@@ -0,0 +1,379 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <signal.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+
+extern struct	HGT_INIT	hgt_init;
+extern volatile sig_atomic_t	StopRequested;
+
+// -------------------------------------------------------------------
+// Each worker owns a queue of tasks [Head, Tail).  The owner takes
+// tasks from the Head, and an idle worker steals from the Tail of
+// another worker's queue.  A task is a whole Gram interval (task
+// numbers 0 through CountGram - 1), the Gram point after the last
+// interval (task CountGram) or the point before the first Gram point
+// (task CountGram + 1, first window only).
+// -------------------------------------------------------------------
+struct POOLQUEUE {
+	pthread_mutex_t	Lock;
+	int				Head;
+	int				Tail;
+};
+
+struct POOL;
+
+struct POOLWORKER {
+	struct POOL *		pPool;
+	int					Worker;
+};
+
+struct POOL {
+	struct TURCTX *		ctx;
+	struct TURING		tur;
+	int					Workers;
+	struct POOLQUEUE	Queue[TUR_WORKERS_MAX];
+	struct POOLWORKER	Arg[TUR_WORKERS_MAX];
+	pthread_t			Thread[TUR_WORKERS_MAX];	// workers 1 on (worker 0 is the main thread)
+	pthread_mutex_t		PrintLock;
+	pthread_mutex_t		Lock;			// guards Round, Running and Quit
+	pthread_cond_t		Start;			// signalled when Round changes (or Quit is set)
+	pthread_cond_t		Finish;			// signalled when Running drops to 0
+	uint64_t			Round;			// windows handed out so far
+	int					Running;		// workers 1 on still busy with this Round
+	bool				Quit;			// T/F: PoolClose wants the workers to exit
+	bool				Done[HGT_TUR_GRAM_PTS_MAX + 2];	// T/F: task completed
+	int					CpuCount;		// -P: entries in Cpu
+	int					Cpu[TUR_CPU_MAX];	// -P: the CPUs, grouped by NUMA node (see CpuPlan)
+};
+
+static struct POOL *	PoolOpen(struct TURCTX *ctx, struct TURING tur);
+static void *	PoolThread(void *pArg);
+static int		PoolTake(struct POOL *pPool, int Worker);
+static int		PoolWorker(struct POOL *pPool, int Worker);
+static int		PoolRunTask(struct POOL *pPool, int Task);
+
+
+// *******************************************************************
+// We compute the Hardy Z values for the current window using
+// tur.Workers worker threads, each computing whole Gram intervals.
+// On return, gList and hInfo hold exactly what the serial loop in
+// HardyZWindow would have given us, and (as there) we return the
+// number of Gram intervals completed.
+//
+// The pool is started with the first window and kept (idle between
+// windows) until PoolClose, at the end of the job.
+// *******************************************************************
+int PoolHardyZWindow(struct TURCTX *ctx, struct TURING tur)
+{
+struct POOL *	pPool;
+int				i, Tasks, Per, Extra, Next, Completed, Slot;
+
+if(ctx->Pool == NULL && (ctx->Pool = PoolOpen(ctx, tur)) == NULL) {
+	return(0);
+	}
+pPool = ctx->Pool;
+
+// -------------------------------------------------------------------
+// Deal the tasks out in contiguous runs, so that (absent stealing)
+// each worker walks through neighbouring Gram intervals.  In a short
+// last window, some workers may get no run at all.
+// -------------------------------------------------------------------
+pPool->tur = tur;
+Tasks = tur.CountGram + (ctx->sweep.Window == 0 ? 2 : 1);
+Per   = Tasks / pPool->Workers;
+Extra = Tasks % pPool->Workers;
+Next  = 0;
+for(i=0; i < pPool->Workers; i++) {
+	pPool->Queue[i].Head = Next;
+	Next += Per + (i < Extra ? 1 : 0);
+	pPool->Queue[i].Tail = Next;
+	}
+memset(pPool->Done, 0, sizeof(pPool->Done));
+
+if(ctx->sweep.Window == 0) {
+	mpfr_sub (ctx->tBefore, ctx->gList[0].Gram, ctx->gList[0].lenSubInterval, MPFR_RNDN);
+	}
+
+// -------------------------------------------------------------------
+// With -P, worker i is pinned to the -k CPUs starting at CpuPlan
+// entry i * k, so that the workers (and their libHGT threads) each
+// have their own CPUs, on one NUMA node where possible.  Workers 1 on
+// were pinned when they started; the main thread is pinned only while
+// it works as worker 0.
+// -------------------------------------------------------------------
+if(tur.Pin == true) {
+	CpuSave();
+	CpuPin(pPool->Cpu, pPool->CpuCount, 0, tur.Threads);
+	}
+
+fprintf(stderr, "Processing Gram interval: ");
+pthread_mutex_lock(&pPool->Lock);
+pPool->Round += 1;
+pPool->Running = pPool->Workers - 1;
+pthread_cond_broadcast(&pPool->Start);
+pthread_mutex_unlock(&pPool->Lock);
+
+Slot = StatsThread(1);
+PoolWorker(pPool, 0);
+StatsThread(Slot);
+
+pthread_mutex_lock(&pPool->Lock);
+while(pPool->Running > 0) {
+	pthread_cond_wait(&pPool->Finish, &pPool->Lock);
+	}
+pthread_mutex_unlock(&pPool->Lock);
+fprintf(stderr, "\n\n");
+if(tur.Pin == true) {
+	CpuRestore();
+	}
+
+// -------------------------------------------------------------------
+// If we were asked to stop, the intervals done may not be a prefix
+// of the window, and the boundary tasks may not have run (even if
+// every interval did).  We keep the completed prefix and take any
+// boundary sample it is missing: the one at the Gram point after it
+// (the first sample of interval Completed, or task CountGram), and
+// tBefore.
+// -------------------------------------------------------------------
+for(Completed = 0; Completed < tur.CountGram && pPool->Done[Completed]; Completed++)
+	;
+pPool->tur.CountGram = Completed;
+if(ctx->sweep.Window == 0 && pPool->Done[tur.CountGram + 1] == false) {
+	PoolRunTask(pPool, Completed + 1);
+	}
+if(pPool->Done[Completed] == false) {
+	PoolRunTask(pPool, Completed);
+	}
+return(Completed);
+}
+
+
+// *******************************************************************
+// We start the pool: tur.Workers - 1 threads (the main thread is
+// worker 0), but never more workers than the tasks in a window.  We
+// return NULL if the pool could not be allocated.  If a thread could
+// not be started, we carry on with the workers we have.
+// *******************************************************************
+static struct POOL * PoolOpen(struct TURCTX *ctx, struct TURING tur)
+{
+struct POOL *	pPool;
+int				i, Workers;
+
+if((pPool = calloc(1, sizeof(struct POOL))) == NULL) {
+	fprintf(stderr, "Unable to allocate the worker pool \n");
+	return(NULL);
+	}
+pPool->ctx = ctx;
+pPool->tur = tur;
+Workers = tur.Workers < tur.CountGram + 2 ? tur.Workers : tur.CountGram + 2;
+for(i=0; i < Workers; i++) {
+	pthread_mutex_init(&pPool->Queue[i].Lock, NULL);
+	pPool->Arg[i].pPool = pPool;
+	pPool->Arg[i].Worker = i;
+	}
+pthread_mutex_init(&pPool->PrintLock, NULL);
+pthread_mutex_init(&pPool->Lock, NULL);
+pthread_cond_init(&pPool->Start, NULL);
+pthread_cond_init(&pPool->Finish, NULL);
+if(tur.Pin == true) {
+	pPool->CpuCount = CpuPlan(pPool->Cpu, TUR_CPU_MAX);
+	}
+
+pPool->Workers = 1;
+for(i=1; i < Workers; i++) {
+	if(pthread_create(&pPool->Thread[i], NULL, PoolThread, &pPool->Arg[i]) != 0) {
+		fprintf(stderr, "Unable to start worker %d, continuing with %d \n", i, i);
+		break;
+		}
+	pPool->Workers = i + 1;
+	}
+return(pPool);
+}
+
+
+// *******************************************************************
+// We stop the pool's threads and free the pool (if there is one).
+// *******************************************************************
+int PoolClose(struct TURCTX *ctx)
+{
+struct POOL *	pPool = ctx->Pool;
+int				i;
+
+if(pPool == NULL) {
+	return(1);
+	}
+pthread_mutex_lock(&pPool->Lock);
+pPool->Quit = true;
+pthread_cond_broadcast(&pPool->Start);
+pthread_mutex_unlock(&pPool->Lock);
+for(i=1; i < pPool->Workers; i++) {
+	pthread_join(pPool->Thread[i], NULL);
+	}
+
+for(i=0; i < pPool->Workers; i++) {
+	pthread_mutex_destroy(&pPool->Queue[i].Lock);
+	}
+pthread_mutex_destroy(&pPool->PrintLock);
+pthread_mutex_destroy(&pPool->Lock);
+pthread_cond_destroy(&pPool->Start);
+pthread_cond_destroy(&pPool->Finish);
+free(pPool);
+ctx->Pool = NULL;
+return(1);
+}
+
+
+// *******************************************************************
+// Workers 1 on each run here for the life of the pool: they wait for
+// the next Round (window), work on it, and report back through
+// Running, until PoolClose sets Quit.
+// *******************************************************************
+static void * PoolThread(void *pArg)
+{
+struct POOL *	pPool = ((struct POOLWORKER *) pArg)->pPool;
+int				Worker = ((struct POOLWORKER *) pArg)->Worker;
+uint64_t		Round = 0;
+
+StatsThread(Worker + 1);
+if(pPool->tur.Pin == true) {
+	CpuPin(pPool->Cpu, pPool->CpuCount, Worker * pPool->tur.Threads, pPool->tur.Threads);
+	}
+
+pthread_mutex_lock(&pPool->Lock);
+while(true) {
+	while(pPool->Quit == false && pPool->Round == Round) {
+		pthread_cond_wait(&pPool->Start, &pPool->Lock);
+		}
+	if(pPool->Quit == true) {
+		break;
+		}
+	Round = pPool->Round;
+	pthread_mutex_unlock(&pPool->Lock);
+
+	PoolWorker(pPool, Worker);
+
+	pthread_mutex_lock(&pPool->Lock);
+	if(--pPool->Running == 0) {
+		pthread_cond_signal(&pPool->Finish);
+		}
+	}
+pthread_mutex_unlock(&pPool->Lock);
+return(NULL);
+}
+
+
+// *******************************************************************
+// A worker runs tasks from its own queue, then steals from the
+// others until no work is left anywhere (or we are asked to stop).
+// *******************************************************************
+static int PoolWorker(struct POOL *pPool, int Worker)
+{
+int				Task;
+
+while(StopRequested == 0 && (Task = PoolTake(pPool, Worker)) >= 0) {
+	PoolRunTask(pPool, Task);
+	pPool->Done[Task] = true;
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// We return the next task for the given worker (or -1 if there is
+// none left).  We try our own queue first, then steal from the Tail
+// of the other queues, starting with our neighbour.
+// *******************************************************************
+static int PoolTake(struct POOL *pPool, int Worker)
+{
+struct POOLQUEUE *	q;
+int					i, Task = -1;
+
+q = &pPool->Queue[Worker];
+pthread_mutex_lock(&q->Lock);
+if(q->Head < q->Tail) {
+	Task = q->Head++;
+	}
+pthread_mutex_unlock(&q->Lock);
+
+for(i=1; Task < 0 && i < pPool->Workers; i++) {
+	q = &pPool->Queue[(Worker + i) % pPool->Workers];
+	pthread_mutex_lock(&q->Lock);
+	if(q->Head < q->Tail) {
+		Task = --q->Tail;
+		}
+	pthread_mutex_unlock(&q->Lock);
+	}
+return(Task);
+}
+
+
+// *******************************************************************
+// We compute the Hardy Z values for one task.  Each task writes only
+// to its own slice of hInfo (through the usual callbacks), so no
+// locking is needed here.
+// *******************************************************************
+static int PoolRunTask(struct POOL *pPool, int Task)
+{
+struct TURCTX *	ctx = pPool->ctx;
+mpfr_t			One;
+int				idx, Escalated = 0;
+
+if(Task < pPool->tur.CountGram) {
+	if(CacheInterval(ctx, pPool->tur, Task) == 0) {
+		if(pPool->tur.Mixed == true) {
+			Escalated = MixedInterval(ctx, pPool->tur, Task);
+			}
+		else {
+			TimedHardyZ(ctx->gList[Task].Gram, ctx->gList[Task].lenSubInterval, pPool->tur.CountZ,
+				TUR_CALLER(ctx, Task), HardyZCallbackA);
+			}
+		CachePutInterval(ctx, pPool->tur, Task);
+		}
+	TextInterval(ctx, pPool->tur, Task);
+	pthread_mutex_lock(&pPool->PrintLock);
+	fprintf(stderr, "%d..", Task);
+	ctx->sweep.MixedEscalated += Escalated;
+	pthread_mutex_unlock(&pPool->PrintLock);
+	return(1);
+	}
+
+idx = Task == pPool->tur.CountGram ? (Task * pPool->tur.CountZ) + 1 : 0;
+if(CachePoint(ctx, pPool->tur, idx) == 1) {
+	return(1);
+	}
+if(pPool->tur.Mixed == true) {
+	Escalated = MixedHardyZ(ctx, pPool->tur, idx);
+	CachePutPoint(ctx, pPool->tur, idx);
+	pthread_mutex_lock(&pPool->PrintLock);
+	ctx->sweep.MixedEscalated += Escalated;
+	pthread_mutex_unlock(&pPool->PrintLock);
+	return(1);
+	}
+
+mpfr_inits2 (hgt_init.DefaultBits, One, (mpfr_ptr) 0);
+mpfr_set_ui(One, 1, MPFR_RNDN);
+if(Task == pPool->tur.CountGram) {
+	TimedHardyZ(ctx->gList[Task].Gram, One, 1, TUR_CALLER(ctx, Task), HardyZCallbackA);
+	}
+else {
+	TimedHardyZ(ctx->tBefore, One, 1, TUR_CALLER(ctx, 0), HardyZCallbackB);
+	}
+CachePutPoint(ctx, pPool->tur, idx);
+mpfr_clears (One, (mpfr_ptr) 0);
+return(1);
+}
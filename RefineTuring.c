@@ -0,0 +1,278 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+
+extern struct	HGT_INIT	hgt_init;
+
+static int		RefineCenter(struct TURCTX *ctx, struct TURING tur, int Center);
+static int		RefineSegment(struct TURCTX *ctx, struct TURING tur, int k);
+static int		RefineBracket(struct TURCTX *ctx, mpfr_t tLo, double zLo, mpfr_t tHi,
+					double zHi, int Level, int MaxLevel);
+static bool		IsLocalMin(struct TURCTX *ctx, int Center, int hzNum);
+
+
+// *******************************************************************
+// With -a, we look again at the sub-intervals where the uniform grid
+// may have missed a pair of zeros: (1) around every sample flagged as
+// a possible Lehmer problem, and (2) around every local minimum of
+// |Z| in a Gram interval whose even/odd zero count is not as expected.
+// Only those sub-intervals are re-sampled (TUR_REFINE_POINTS at a time),
+// zooming in on the smallest |Z| until we find the missing sign
+// changes or reach the -a refinement level.
+//
+// Any zero crossings we find are added to gList[].ZerosFound and
+// saved in hInfo[].RefineZeros, so the report sees them, and the
+// flags of the samples either side are brought up to date.
+// *******************************************************************
+int RefineWindow(struct TURCTX *ctx, struct TURING tur)
+{
+int		i, k, hzNum, First, Last;
+
+hzNum = (tur.CountGram * ctx->CountZ) + 1;
+memset(ctx->Refined, 0, sizeof(bool) * (hzNum + 1));
+for(k=0; k <= hzNum; k++) {
+	ctx->hInfo[k].RefineZeros = 0;
+	}
+
+// -------------------------------------------------------------------
+// The sample before a flagged Lehmer sample is the one closest to
+// zero, so that is where we look.
+// -------------------------------------------------------------------
+for(k=2; k <= hzNum; k++) {
+	if(ctx->hInfo[k].Lehmer == true) {
+		RefineCenter(ctx, tur, k - 1);
+		}
+	}
+
+// -------------------------------------------------------------------
+// For Gram intervals that still have an unexpected even/odd zero
+// count, we look at every local minimum of |Z| in the interval.
+// -------------------------------------------------------------------
+for(i=0; i < tur.CountGram; i++) {
+	if((ctx->gList[i].ZerosFound % 2 == 0) != ctx->gList[i].OddZeros) {
+		continue;
+		}
+	First = (i * ctx->CountZ) + 1;
+	Last  = First + ctx->CountZ;
+	for(k=First; k <= Last; k++) {
+		if(IsLocalMin(ctx, k, hzNum) == true) {
+			RefineCenter(ctx, tur, k);
+			}
+		}
+	}
+
+// -------------------------------------------------------------------
+// Where we found crossings in the sub-interval ending at sample k, Z
+// crossed zero there (although it has the same sign at both ends), so
+// sample k is a ZeroCross.  The turn in Z that would flag sample k or
+// k + 1 as a possible Lehmer point is then explained.
+// -------------------------------------------------------------------
+for(k=2; k <= hzNum; k++) {
+	if(ctx->hInfo[k].RefineZeros > 0) {
+		ctx->hInfo[k].ZeroCross = true;
+		ctx->hInfo[k].Lehmer = false;
+		if(k + 1 <= hzNum) {
+			ctx->hInfo[k + 1].Lehmer = false;
+			}
+		}
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// We refine the two sub-intervals on either side of hInfo[Center].
+// *******************************************************************
+static int RefineCenter(struct TURCTX *ctx, struct TURING tur, int Center)
+{
+int		hzNum = (tur.CountGram * ctx->CountZ) + 1;
+
+if(Center >= 2) {
+	RefineSegment(ctx, tur, Center);
+	}
+if(Center + 1 <= hzNum) {
+	RefineSegment(ctx, tur, Center + 1);
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// We refine the sub-interval between hInfo[k-1] and hInfo[k], which
+// belongs to Gram interval (k - 2) / CountZ.  Each sub-interval is
+// refined at most once per window.
+// *******************************************************************
+static int RefineSegment(struct TURCTX *ctx, struct TURING tur, int k)
+{
+mpfr_t	tLo, tHi;
+int		Found;
+
+if(ctx->Refined[k] == true || ctx->hInfo[k].ZeroCross == true) {
+	return(0);
+	}
+ctx->Refined[k] = true;
+
+mpfr_inits2 (hgt_init.DefaultBits, tLo, tHi, (mpfr_ptr) 0);
+HardyT(ctx, tLo, tur, k - 1);
+HardyT(ctx, tHi, tur, k);
+Found = RefineBracket(ctx, tLo, ctx->hInfo[k-1].hzValue, tHi, ctx->hInfo[k].hzValue, 1, tur.Refine);
+mpfr_clears (tLo, tHi, (mpfr_ptr) 0);
+
+ctx->sweep.RefineSegments += 1;
+if(Found > 0) {
+	ctx->hInfo[k].RefineZeros = Found;
+	ctx->gList[(k - 2) / ctx->CountZ].ZerosFound += Found;
+	ctx->sweep.RefineZeros += Found;
+	}
+return(Found);
+}
+
+
+// *******************************************************************
+// We sample Z at TUR_REFINE_POINTS equally spaced points strictly
+// inside [tLo, tHi] and return the number of sign changes found.  If
+// there are none and we have not reached MaxLevel, we zoom in on the
+// two steps either side of the smallest |Z| and try again.
+// *******************************************************************
+static int RefineBracket(struct TURCTX *ctx, mpfr_t tLo, double zLo, mpfr_t tHi,
+	double zHi, int Level, int MaxLevel)
+{
+mpfr_t	Step, tStart, tNewLo, tNewHi;
+double	z[TUR_REFINE_POINTS + 2];
+int		j, m, Found;
+
+mpfr_inits2 (hgt_init.DefaultBits, Step, tStart, tNewLo, tNewHi, (mpfr_ptr) 0);
+mpfr_sub (Step, tHi, tLo, MPFR_RNDN);
+mpfr_div_ui (Step, Step, TUR_REFINE_POINTS + 1, MPFR_RNDN);
+mpfr_add (tStart, tLo, Step, MPFR_RNDN);
+
+TimedHardyZ(tStart, Step, TUR_REFINE_POINTS, TUR_CALLER(ctx, 0), HardyZCallbackR);
+ctx->sweep.RefineEvals += TUR_REFINE_POINTS;
+
+z[0] = zLo;
+z[TUR_REFINE_POINTS + 1] = zHi;
+for(j=1; j <= TUR_REFINE_POINTS; j++) {
+	z[j] = ctx->hzRefine[j - 1];
+	}
+
+Found = 0;
+m = 1;
+for(j=1; j <= TUR_REFINE_POINTS + 1; j++) {
+	if(z[j] * z[j-1] < 0) {
+		Found += 1;
+		}
+	if(j <= TUR_REFINE_POINTS && fabs(z[j]) < fabs(z[m])) {
+		m = j;
+		}
+	}
+
+if(Found == 0 && Level < MaxLevel) {
+	mpfr_mul_si (tNewLo, Step, m - 1, MPFR_RNDN);
+	mpfr_add (tNewLo, tLo, tNewLo, MPFR_RNDN);
+	mpfr_mul_si (tNewHi, Step, m + 1, MPFR_RNDN);
+	mpfr_add (tNewHi, tLo, tNewHi, MPFR_RNDN);
+	Found = RefineBracket(ctx, tNewLo, z[m-1], tNewHi, z[m+1], Level + 1, MaxLevel);
+	}
+
+mpfr_clears (Step, tStart, tNewLo, tNewHi, (mpfr_ptr) 0);
+return(Found);
+}
+
+
+// *******************************************************************
+// T/F: hInfo[Center] is a local minimum of |Z| with no sign change on
+// either side (so a pair of zeros may be hiding next to it).
+// *******************************************************************
+static bool IsLocalMin(struct TURCTX *ctx, int Center, int hzNum)
+{
+if(Center < 1 || Center + 1 > hzNum) {
+	return(false);
+	}
+if(ctx->hInfo[Center].hzValue * ctx->hInfo[Center-1].hzValue < 0
+	|| ctx->hInfo[Center].hzValue * ctx->hInfo[Center+1].hzValue < 0) {
+	return(false);
+	}
+return(fabs(ctx->hInfo[Center].hzValue) <= fabs(ctx->hInfo[Center-1].hzValue)
+	&& fabs(ctx->hInfo[Center].hzValue) <= fabs(ctx->hInfo[Center+1].hzValue));
+}
+
+
+// *******************************************************************
+// We set 't' to the point at which hInfo[idx] was computed.  Index 0
+// is the point before the first Gram point, and index
+// (CountGram * CountZ) + 1 is the Gram point after the last interval.
+// *******************************************************************
+int HardyT(struct TURCTX *ctx, mpfr_t t, struct TURING tur, int idx)
+{
+int		i, j;
+
+if(idx == 0) {
+	mpfr_set (t, ctx->tBefore, MPFR_RNDN);
+	return(1);
+	}
+i = (idx - 1) / ctx->CountZ;
+j = (idx - 1) % ctx->CountZ;
+if(i >= tur.CountGram) {
+	mpfr_set (t, ctx->gList[tur.CountGram].Gram, MPFR_RNDN);
+	return(1);
+	}
+mpfr_mul_si (t, ctx->gList[i].lenSubInterval, j, MPFR_RNDN);
+mpfr_add (t, ctx->gList[i].Gram, t, MPFR_RNDN);
+return(1);
+}
+
+
+// *******************************************************************
+// In a verbose report, we list each sub-interval in which refinement
+// found the missing zero crossings.
+// *******************************************************************
+int RefineReport(struct TURCTX *ctx, struct TURING tur)
+{
+int		k, hzNum;
+
+hzNum = (tur.CountGram * ctx->CountZ) + 1;
+fprintf(ctx->fpOut, "\nAdaptive refinement found the following additional zero crossings:\n\n");
+for(k=2; k <= hzNum; k++) {
+	if(ctx->hInfo[k].RefineZeros > 0) {
+		fprintf(ctx->fpOut, "Gram idx = %d, between points %2d and %2d, Zeros Found = %d \n",
+			(k - 2) / ctx->CountZ, (k - 2) % ctx->CountZ, (k - 2) % ctx->CountZ + 1, ctx->hInfo[k].RefineZeros);
+		}
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// The callback used by HardyZWithCount during refinement.
+// *******************************************************************
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+int HardyZCallbackR(mpfr_t t, mpfr_t HardyZ, int i, int CallerID)
+{
+struct TURCTX *	ctx = TuringCtxOf(CallerID);
+ctx->hzRefine[i] = mpfr_get_d (HardyZ, MPFR_RNDN);
+return(1);
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+#pragma GCC diagnostic pop
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -0,0 +1,198 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <signal.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+
+extern struct	HGT_INIT	hgt_init;
+extern volatile sig_atomic_t	StopRequested;
+
+static int		RosserSamples(struct TURCTX *ctx, struct TURING tur, int idx, int Count, mpfr_t Incr);
+
+
+// *******************************************************************
+// With -R, we compute the current window one Gram interval at a time,
+// and after each interval we apply Rosser's rule (see RosserInterval).
+// We stop as soon as the sweep has found K consecutive Gram blocks
+// that satisfy Rosser's rule, where K is from ComputeTuringK.
+//
+// So that we never compute a Hardy Z value we do not need, the Gram
+// point that ends interval i is computed right after the rest of
+// interval i (rather than with interval i+1).  As with HardyZWindow,
+// we return the number of Gram intervals completed.
+// *******************************************************************
+int RosserHardyZWindow(struct TURCTX *ctx, struct TURING tur)
+{
+mpfr_t	One;
+int		i;
+bool	Done = false;
+
+mpfr_inits2 (hgt_init.DefaultBits, One, (mpfr_ptr) 0);
+mpfr_set_ui(One, 1, MPFR_RNDN);
+
+// -------------------------------------------------------------------
+// In the first window, we also need the sample before the first Gram
+// point and the sample at the first Gram point.  In a later window,
+// both were carried from the previous window.
+// -------------------------------------------------------------------
+fprintf(stderr, "Processing Gram interval: ");
+if(ctx->sweep.Window == 0) {
+	mpfr_sub (ctx->tBefore, ctx->gList[0].Gram, ctx->gList[0].lenSubInterval, MPFR_RNDN);
+	RosserSamples(ctx, tur, 0, 1, One);
+	RosserSamples(ctx, tur, 1, 1, One);
+	}
+
+for(i=0; i < tur.CountGram && StopRequested == 0 && Done == false; i++) {
+	RosserSamples(ctx, tur, (i * ctx->CountZ) + 2, ctx->CountZ - 1, ctx->gList[i].lenSubInterval);
+	RosserSamples(ctx, tur, ((i + 1) * ctx->CountZ) + 1, 1, One);
+	TextInterval(ctx, tur, i);
+	fprintf(stderr, "%d..", i);
+	Done = RosserInterval(ctx, tur, i) == 1 ? true : false;
+	}
+fprintf(stderr, "\n\n");
+
+mpfr_clears (One, (mpfr_ptr) 0);
+return(i);
+}
+
+
+// *******************************************************************
+// We apply Rosser's rule to the Gram blocks that end in the first
+// Count Gram intervals of the current window (whose Hardy Z values
+// were computed some other way, such as by the -w worker threads).
+// We return the number of Gram intervals up to and including the one
+// that completed the K consecutive Gram blocks, or Count.
+// *******************************************************************
+int RosserScan(struct TURCTX *ctx, struct TURING tur, int Count)
+{
+int		i;
+
+for(i=0; i < Count; i++) {
+	if(RosserInterval(ctx, tur, i) == 1) {
+		return(i + 1);
+		}
+	}
+return(Count);
+}
+
+
+// *******************************************************************
+// A Gram block is the run of Gram intervals from one good Gram point
+// to the next.  Rosser's rule says a Gram block of m intervals holds
+// at least m zeros.  With the Hardy Z samples of Gram interval i (and
+// the sample at the Gram point that ends it) in hand, we add interval
+// i to the open Gram block.  If the Gram point ending interval i is
+// good, that block is complete: we check it against Rosser's rule,
+// and begin a new block.
+//
+// The zeros counted here are the sign changes between the samples
+// (the same as AnalyzeWindow, but without -a refinement).  We return
+// 1 once K consecutive Gram blocks satisfy Rosser's rule.
+// *******************************************************************
+int RosserInterval(struct TURCTX *ctx, struct TURING tur, int i)
+{
+int		j, idx, Zeros = 0;
+bool	Good;
+
+// -------------------------------------------------------------------
+// The very first Gram point of the sweep opens a block only if good.
+// -------------------------------------------------------------------
+if(ctx->sweep.Window == 0 && i == 0) {
+	ctx->sweep.BlockOpen = ctx->gList[0].MinusOneToN * ctx->hInfo[1].hzValue > 0 ? true : false;
+	ctx->sweep.BlockLen = ctx->sweep.BlockZeros = 0;
+	}
+
+idx = (i * ctx->CountZ) + 2;
+for(j = 0; j < tur.CountZ; j++) {
+	if(ctx->hInfo[idx + j].hzValue * ctx->hInfo[idx + j - 1].hzValue < 0) {
+		Zeros++;
+		}
+	}
+if(tur.Classify == true && ctx->gList[i].Settled == true) {
+	Zeros = 1;				// see ClassHardyZWindow
+	}
+if(ctx->sweep.BlockOpen == true) {
+	ctx->sweep.BlockLen += 1;
+	ctx->sweep.BlockZeros += Zeros;
+	}
+
+Good = ctx->gList[i+1].MinusOneToN * ctx->hInfo[((i + 1) * ctx->CountZ) + 1].hzValue > 0 ? true : false;
+if(Good == false) {
+	return(0);
+	}
+if(ctx->sweep.BlockOpen == true) {
+	ctx->sweep.RosserBlocks += 1;
+	if(ctx->sweep.BlockZeros >= ctx->sweep.BlockLen) {
+		ctx->sweep.RosserRun += 1;
+		}
+	else {
+		ctx->sweep.RosserRun = 0;
+		ctx->sweep.RosserFailed += 1;
+		}
+	}
+ctx->sweep.BlockOpen = true;
+ctx->sweep.BlockLen = ctx->sweep.BlockZeros = 0;
+
+if(ctx->sweep.RosserRun >= ctx->sweep.RosserK) {
+	ctx->sweep.RosserDone = true;
+	ctx->sweep.RosserEndN = mpfr_get_uj (ctx->gList[i+1].n, MPFR_RNDN);
+	return(1);
+	}
+return(0);
+}
+
+
+// *******************************************************************
+// At the end of the run, we report what Rosser's rule found.
+// *******************************************************************
+int RosserReport(struct TURCTX *ctx)
+{
+if(ctx->sweep.RosserDone == true) {
+	fprintf(ctx->fpOut, "Rosser's rule: %d consecutive Gram blocks found, ending at Gram point n = %ju \n",
+		ctx->sweep.RosserK, (uintmax_t) ctx->sweep.RosserEndN);
+	}
+else {
+	fprintf(ctx->fpOut, "Rosser's rule: only %d of the %d consecutive Gram blocks needed were found \n",
+		ctx->sweep.RosserRun, ctx->sweep.RosserK);
+	}
+fprintf(ctx->fpOut, "Gram blocks checked = %ju, Rosser's rule failures = %ju \n",
+	(uintmax_t) ctx->sweep.RosserBlocks, (uintmax_t) ctx->sweep.RosserFailed);
+return(1);
+}
+
+
+// *******************************************************************
+// We compute Count Hardy Z samples, Incr apart, starting with hInfo
+// index idx (see HardyT).
+// *******************************************************************
+static int RosserSamples(struct TURCTX *ctx, struct TURING tur, int idx, int Count, mpfr_t Incr)
+{
+mpfr_t	t;
+int		k;
+
+if(tur.Mixed == true) {
+	for(k = 0; k < Count; k++) {
+		ctx->sweep.MixedEscalated += MixedHardyZ(ctx, tur, idx + k);
+		}
+	return(1);
+	}
+mpfr_inits2 (hgt_init.DefaultBits, t, (mpfr_ptr) 0);
+HardyT(ctx, t, tur, idx);
+TimedHardyZ(t, Incr, Count, TUR_CALLER(ctx, idx), HardyZCallbackC);
+mpfr_clears (t, (mpfr_ptr) 0);
+return(1);
+}
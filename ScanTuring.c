@@ -0,0 +1,89 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "turscan.h"
+
+
+// *******************************************************************
+// In one pass over Z[0 .. Count-1], we find for each sample k >= 1:
+// the rise (fall) Rise[k] = Z[k] - Z[k-1]; whether the sample moves
+// toward zero; whether Z changed sign since Z[k-1]; and whether it is
+// a possible Lehmer point (it moves away from zero without a sign
+// change, right after a sample that moved toward zero).  These are
+// the three loops AnalyzeWindow makes over hInfo, fused.
+//
+// The flags of sample 0, and the ZeroCross flag of sample 1, were
+// found in the previous sweep window (or are false in the first), so
+// we take them as given: the caller sets bit 0 of Toward, Cross and
+// Lehmer, and bit 1 of Cross, and we leave those bits alone.
+//
+// We work a word (64 samples) at a time.  The inner loop has no
+// branches, so the compiler can vectorize the compares; the Lehmer
+// test is then three bitwise operations on the whole word, with the
+// TowardZero flag of the last sample of the previous word shifted in.
+// *******************************************************************
+int ScanSamples(const double *Z, int64_t Count, double *Rise, uint64_t *Toward,
+	uint64_t *Cross, uint64_t *Lehmer)
+{
+uint64_t	t, c, Given, Prev, Mask;
+int64_t		w, k, Base, End;
+
+Prev = 0;
+for(w = 0; w < TURSCAN_WORDS(Count); w++) {
+	Base = w * TURSCAN_BITS;
+	End = Count - Base < TURSCAN_BITS ? Count - Base : TURSCAN_BITS;
+	t = c = 0;
+	for(k = (w == 0 ? 1 : 0); k < End; k++) {
+		Rise[Base + k] = Z[Base + k] - Z[Base + k - 1];
+		t |= (uint64_t) !(Rise[Base + k] * Z[Base + k] > 0) << k;
+		c |= (uint64_t) (Z[Base + k] * Z[Base + k - 1] < 0) << k;
+		}
+	Mask = End == TURSCAN_BITS ? ~(uint64_t) 0 : ((uint64_t) 1 << End) - 1;
+	if(w == 0) {
+		Given = Lehmer[0] & 1;
+		t = (t & ~(uint64_t) 1) | (Toward[0] & 1);
+		c = (c & ~(uint64_t) 3) | (Cross[0] & 3);
+		Lehmer[0] = ((~t & ~c & (t << 1)) & Mask & ~(uint64_t) 1) | Given;
+		}
+	else {
+		Lehmer[w] = ~t & ~c & ((t << 1) | Prev) & Mask;
+		}
+	Toward[w] = t;
+	Cross[w] = c;
+	Prev = t >> (TURSCAN_BITS - 1);
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// We count the bits set in Bits from First through Last (inclusive).
+// *******************************************************************
+int ScanCount(const uint64_t *Bits, int64_t First, int64_t Last)
+{
+uint64_t	Word;
+int64_t		w;
+int			Count;
+
+Count = 0;
+for(w = First / TURSCAN_BITS; w <= Last / TURSCAN_BITS; w++) {
+	Word = Bits[w];
+	if(w == First / TURSCAN_BITS) {
+		Word &= ~(uint64_t) 0 << (First % TURSCAN_BITS);
+		}
+	if(w == Last / TURSCAN_BITS && Last % TURSCAN_BITS != TURSCAN_BITS - 1) {
+		Word &= ((uint64_t) 1 << ((Last % TURSCAN_BITS) + 1)) - 1;
+		}
+	Count += __builtin_popcountll(Word);
+	}
+return(Count);
+}
@@ -0,0 +1,104 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+
+extern struct	HGT_INIT	hgt_init;
+
+// *******************************************************************
+// With -S, we split the requested sweep (-t or -n, with -T or -G)
+// into Shards pieces that begin and end on exact Gram points, and
+// print one command line per shard.  Each shard starts with -n at its
+// first Gram point and covers its intervals with -G, so neighbouring
+// shards share exactly one Gram point: the last sample of one shard's
+// -B file is the first Gram point of the next.  The shards can then
+// run anywhere, in any order, and turmerge stitches their -B files
+// back together.  Nothing is computed but the Gram indices.
+// *******************************************************************
+int PlanShards(struct TURING tur)
+{
+mpfr_t		t, n;
+uint64_t	StartN, Total, Count, Each, Extra;
+int			k;
+
+if(tur.TBuf[0] == '\0' && tur.SweepGram == 0) {
+	printf("The -S parameter requires -T or -G (the range to split).\n");
+	return(0);
+	}
+
+TuringOpen(tur);
+mpfr_inits2 (hgt_init.DefaultBits, t, n, (mpfr_ptr) 0);
+if(tur.StartN > 0) {
+	StartN = tur.StartN;
+	}
+else {
+	mpfr_set_str (t, tur.tBuf, 10, MPFR_RNDN);
+	GramNearT(&n, t);
+	StartN = mpfr_get_uj (n, MPFR_RNDN);
+	}
+Total = tur.SweepGram;
+if(tur.TBuf[0] != '\0') {
+	mpfr_set_str (t, tur.TBuf, 10, MPFR_RNDN);
+	GramNearT(&n, t);
+	Total = mpfr_get_uj (n, MPFR_RNDN) - StartN + 1;
+	}
+mpfr_clears (t, n, (mpfr_ptr) 0);
+TuringClose();
+
+// -------------------------------------------------------------------
+// The shards differ in size by at most one Gram interval.
+// -------------------------------------------------------------------
+tur.Shards = (uint64_t) tur.Shards < Total ? tur.Shards : (int) Total;
+Each  = Total / tur.Shards;
+Extra = Total % tur.Shards;
+printf("# Shard plan: Gram intervals n = %ju through %ju (%ju intervals) in %d shards \n",
+	(uintmax_t) StartN, (uintmax_t) (StartN + Total - 1), (uintmax_t) Total, tur.Shards);
+printf("# Merge with: turmerge %s-*.bin \n", tur.BinFile);
+for(k = 0; k < tur.Shards; k++) {
+	Count = Each + ((uint64_t) k < Extra ? 1 : 0);
+	printf("turing -n %ju -G %ju -g %d -c %d -b %d%s -B %s-%03d.bin \n",
+		(uintmax_t) StartN, (uintmax_t) Count, tur.CountGram, tur.CountZ,
+		tur.DefaultBits, tur.Grid == true ? " -E" : tur.Mixed == true ? " -m" : "", tur.BinFile, k);
+	StartN += Count;
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// With -n (and no -t), we still want a 't' for -b auto and for the
+// checkpoint, so we return g(n) to double precision.  We solve
+// theta(t) = n pi by Newton's method, with the usual asymptotic
+// theta(t) = (t/2) log(t / 2 pi) - t/2 - pi/8 + 1/(48 t).
+// *******************************************************************
+double GramApprox(uint64_t n)
+{
+double	t, Theta, Target, Step;
+int		i;
+
+Target = (double) n * M_PI;
+t = 20 + (2 * M_PI * (double) n) / log((double) n + 2);
+for(i=0; i < 100; i++) {
+	Theta = ((t / 2) * log(t / (2 * M_PI))) - (t / 2) - (M_PI / 8) + (1 / (48 * t));
+	Step = (Theta - Target) / (0.5 * log(t / (2 * M_PI)));
+	t = (t - Step) > 10 ? t - Step : 10;
+	if(fabs(Step) < 1e-9 * t) {
+		break;
+		}
+	}
+return(t);
+}
@@ -0,0 +1,229 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <time.h>
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+
+struct STATSPHASE {
+	uint64_t		Calls;
+	double			Wall;			// seconds
+	double			Cpu;			// seconds (all threads of the process)
+};
+
+static const char *	PhaseName[TUR_PHASE_COUNT] = { "setup", "gram_near",
+	"gram_points", "hardy_z", "refine", "analysis", "report", "output", "zeros" };
+
+static struct STATSPHASE	Phase[TUR_PHASE_COUNT];
+static pthread_mutex_t		StatsLock = PTHREAD_MUTEX_INITIALIZER;
+static struct timespec		StatsStart;
+static uint64_t				Evals, Calls;
+static double				EvalMin, EvalMax, EvalSum;
+static uint64_t				Hist[TUR_STATS_BUCKETS];
+static double				Busy[TUR_WORKERS_MAX + 1];
+static _Thread_local int	StatsSlot = 0;	// 0 = main thread, else -w worker + 1
+static _Thread_local struct timespec	WallStart[TUR_PHASE_COUNT];	// per thread, as
+static _Thread_local struct timespec	CpuStart[TUR_PHASE_COUNT];	// contexts may overlap
+
+static double	StatsSeconds(struct timespec *pStart, struct timespec *pEnd);
+static double	StatsP99(void);
+
+
+// *******************************************************************
+// We count and time the program in phases (see TUR_PHASE_xxx), with
+// the wall clock and the process CPU clock, and we count and time
+// every Hardy Z evaluation (see TimedHardyZ).  The -s parameter
+// prints all this as a table, and -J prints it as one line of JSON.
+// *******************************************************************
+int StatsInit(void)
+{
+memset(Phase, 0, sizeof(Phase));
+memset(Hist, 0, sizeof(Hist));
+memset(Busy, 0, sizeof(Busy));
+Evals = Calls = 0;
+EvalMin = EvalMax = EvalSum = 0;
+clock_gettime(CLOCK_MONOTONIC, &StatsStart);
+return(1);
+}
+
+
+int StatsBegin(int Which)
+{
+clock_gettime(CLOCK_MONOTONIC, &WallStart[Which]);
+clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &CpuStart[Which]);
+return(1);
+}
+
+
+int StatsEnd(int Which)
+{
+struct timespec	Wall, Cpu;
+
+clock_gettime(CLOCK_MONOTONIC, &Wall);
+clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &Cpu);
+pthread_mutex_lock(&StatsLock);
+Phase[Which].Wall += StatsSeconds(&WallStart[Which], &Wall);
+Phase[Which].Cpu  += StatsSeconds(&CpuStart[Which], &Cpu);
+Phase[Which].Calls += 1;
+pthread_mutex_unlock(&StatsLock);
+return(1);
+}
+
+
+// *******************************************************************
+// The -w worker threads call this (with their worker number + 1) so
+// that their Hardy Z time is counted as theirs.  We return the slot
+// the thread had, so that the main thread (which is also worker 0)
+// can have it back.
+// *******************************************************************
+int StatsThread(int Slot)
+{
+int		Prev = StatsSlot;
+
+StatsSlot = Slot;
+return(Prev);
+}
+
+
+// *******************************************************************
+// Every HardyZWithCount call in the program goes through here.  The
+// library gives us one call for Count values, so the latency of each
+// evaluation is taken as the call's time divided by Count.
+// *******************************************************************
+int TimedHardyZ(mpfr_t t, mpfr_t Incr, int Count, int CallerID,
+	int (*Callback)(mpfr_t t, mpfr_t HardyZ, int i, int CallerID))
+{
+struct timespec	Start, End;
+double			Seconds, Each;
+int				Result, Bucket;
+
+clock_gettime(CLOCK_MONOTONIC, &Start);
+Result = HardyZWithCount(t, Incr, Count, CallerID, Callback);
+clock_gettime(CLOCK_MONOTONIC, &End);
+Seconds = StatsSeconds(&Start, &End);
+Each = Seconds / (Count > 0 ? Count : 1);
+
+// -------------------------------------------------------------------
+// The latency histogram has 4 buckets per power of 2 nanoseconds.
+// -------------------------------------------------------------------
+Bucket = Each > 1e-9 ? (int) (4 * log2(Each * 1e9)) : 0;
+Bucket = Bucket < TUR_STATS_BUCKETS ? Bucket : TUR_STATS_BUCKETS - 1;
+
+pthread_mutex_lock(&StatsLock);
+if(Evals == 0 || Each < EvalMin) {
+	EvalMin = Each;
+	}
+if(Each > EvalMax) {
+	EvalMax = Each;
+	}
+EvalSum += Seconds;
+Evals += Count;
+Calls += 1;
+Hist[Bucket] += Count;
+Busy[StatsSlot] += Seconds;
+pthread_mutex_unlock(&StatsLock);
+return(Result);
+}
+
+
+// *******************************************************************
+// We print the phase table (-s) or the JSON line (-J).  Thread
+// utilization is each thread's Hardy Z time as a percentage of the
+// wall time of the hardy_z, refine and zeros phases (where all the
+// Hardy Z values are computed).
+// *******************************************************************
+int StatsReport(bool Json)
+{
+struct timespec	Now;
+double			Total, Mean, HardyWall;
+int				i;
+bool			First = true;
+
+clock_gettime(CLOCK_MONOTONIC, &Now);
+Total = StatsSeconds(&StatsStart, &Now);
+Mean = Evals > 0 ? EvalSum / Evals : 0;
+HardyWall = Phase[TUR_PHASE_HARDYZ].Wall + Phase[TUR_PHASE_REFINE].Wall + Phase[TUR_PHASE_ZEROS].Wall;
+
+if(Json == true) {
+	printf("{\"total_wall\":%.6f,\"phases\":{", Total);
+	for(i=0; i < TUR_PHASE_COUNT; i++) {
+		printf("%s\"%s\":{\"calls\":%ju,\"wall\":%.6f,\"cpu\":%.6f}", i == 0 ? "" : ",",
+			PhaseName[i], (uintmax_t) Phase[i].Calls, Phase[i].Wall, Phase[i].Cpu);
+		}
+	printf("},\"hardy_z\":{\"evals\":%ju,\"calls\":%ju,\"min\":%.9f,\"mean\":%.9f,\"p99\":%.9f},",
+		(uintmax_t) Evals, (uintmax_t) Calls, EvalMin, Mean, StatsP99());
+	printf("\"threads\":[");
+	for(i=0; i <= TUR_WORKERS_MAX; i++) {
+		if(Busy[i] > 0) {
+			printf("%s{\"thread\":%d,\"busy\":%.6f,\"utilization\":%.4f}", First ? "" : ",",
+				i, Busy[i], HardyWall > 0 ? Busy[i] / HardyWall : 0);
+			First = false;
+			}
+		}
+	printf("]}\n");
+	return(1);
+	}
+
+printf("\n%-12s %10s %12s %12s\n", "Phase", "Calls", "Wall (s)", "CPU (s)");
+for(i=0; i < TUR_PHASE_COUNT; i++) {
+	printf("%-12s %10ju %12.6f %12.6f\n", PhaseName[i], (uintmax_t) Phase[i].Calls,
+		Phase[i].Wall, Phase[i].Cpu);
+	}
+printf("%-12s %10s %12.6f\n", "total", "", Total);
+printf("\nHardy Z evaluations = %ju (in %ju calls), seconds per evaluation: min = %.6f, mean = %.6f, p99 = %.6f \n",
+	(uintmax_t) Evals, (uintmax_t) Calls, EvalMin, Mean, StatsP99());
+printf("Thread utilization during hardy_z, refine and zeros:");
+for(i=0; i <= TUR_WORKERS_MAX; i++) {
+	if(Busy[i] > 0) {
+		if(i == 0) {
+			printf(" main %.1f%%", HardyWall > 0 ? 100 * Busy[i] / HardyWall : 0);
+			}
+		else {
+			printf(" worker%d %.1f%%", i, HardyWall > 0 ? 100 * Busy[i] / HardyWall : 0);
+			}
+		}
+	}
+printf("\n\n");
+return(1);
+}
+
+
+// *******************************************************************
+// The 99th percentile latency, from the histogram: the top of the
+// bucket holding it (but no more than the largest latency seen).
+// *******************************************************************
+static double StatsP99(void)
+{
+uint64_t	Sum = 0;
+double		Top;
+int			i;
+
+for(i=0; i < TUR_STATS_BUCKETS; i++) {
+	Sum += Hist[i];
+	if(Sum > 0 && Sum >= (uint64_t) ceil(0.99 * (double) Evals)) {
+		Top = pow(2, (i + 1) / 4.0) * 1e-9;
+		return(Top < EvalMax ? Top : EvalMax);
+		}
+	}
+return(EvalMax);
+}
+
+
+static double StatsSeconds(struct timespec *pStart, struct timespec *pEnd)
+{
+return((double) (pEnd->tv_sec - pStart->tv_sec)
+	+ ((double) (pEnd->tv_nsec - pStart->tv_nsec) / 1000000000.0));
+}
@@ -45,13 +45,36 @@ SOFTWARE.
 const char sUsage[] = "Command Line Parameters\n" \
  "-t [positive number]	Location of t along the critical line - this parameter is required. (Digits and '.' only).\n" \
  "-g [positive integer]	Count of the number of Gram intervals to check - between 1 and 24, defaults to 8.\n" \
+ "-T [positive number]	Sweep from 't' through this 'T', in windows of '-g' Gram intervals (Digits and '.' only).\n" \
+ "-G [positive integer]	Sweep this many Gram intervals (no upper bound), in windows of '-g' Gram intervals.\n" \
+ "-n [positive integer]	Start at Gram point 'n' exactly, instead of at the Gram point at or before 't'.\n" \
+ "-S [positive integer]	Print a plan that splits the -T or -G sweep into this many shards on Gram point boundaries (see turmerge).\n" \
+ "-M			Calibrate on this machine, then predict the run time and suggest -b, -k, -w and -g, without doing the run.\n" \
  "-c [positive integer]	Count of the number of Z(t) values to check in a Gram interval - between 8 and 128, defaults to 8.\n" \
  "-p [positive integer]	Decimal point digits of 't values to show in report - between 2 and 60, defaults to 6.\n" \
- "-b [positive integer]	Floating point bits: 128 <= b <= 1024 - defaults to 256.\n" \
+ "-b [positive integer]	Floating point bits: 128 <= b <= 1024 - defaults to 256.  Or \"auto\" to choose the bits from 't'.\n" \
  "-d [positive integer]	Used for debugging only.  Please disregard.\n" \
- "-k [positive integer]	Number of threads to use - defaults to 1, maximum of 8.\n" \
+ "-k [positive integer]	Number of threads to use - defaults to 1, maximum of 8.  Or \"auto\" to share out the CPUs left by -w.\n" \
+ "-w [positive integer]	Number of worker threads, each computing whole Gram intervals - defaults to 1, at most -g + 2 (and 256).  Or \"auto\" for one per CPU.  Needs a thread-safe libHGT (HardyZWithCount is called from several threads at once).\n" \
+ "-P			Pin each -w worker thread (and its -k threads) to its own CPUs, keeping each worker on one NUMA node (with -w 1, the main thread).\n" \
+ "-a [positive integer]	Adaptive refinement: re-sample suspect sub-intervals, zooming in up to this many levels (1 to 16).\n" \
+ "-C [file name]		Checkpoint file, rewritten after each window.  SIGINT/SIGTERM stop at the next Gram interval.\n" \
+ "-r			Resume from the -C checkpoint file (all other parameters must be the same as before).\n" \
+ "-H [file name]		Cache file: Gram points and Hardy Z samples are read from it when there, and added to it when computed.\n" \
+ "-I [file name]		Gram point index (built with -X): the first Gram point of each job is located from its nearest entry.\n" \
+ "-X [positive integer]	Build the -I index over the -T or -G sweep, with an entry every this many Gram points (at most 100000).\n" \
+ "-B [file name]		Also write the Hardy Z samples to this binary file (see turbin.h and turdump).\n" \
+ "-f [file name]		Batch mode: one job per line of the file (or stdin for \"-\"), each line a 't' value with optional -g and -c.\n" \
+ "-D [socket path]	Daemon mode: answer requests (each a line of job parameters, such as \"-t 7005 -g 4\") on this Unix-domain socket, with -w workers.\n" \
+ "-R			Sweep (one Gram interval at a time) until K consecutive Gram blocks satisfy Rosser's rule, then stop.\n" \
+ "-m			Mixed precision: compute Hardy Z in double precision, and with MPFR only when |Z| is within an error estimate (heuristic: only the remainder term of that estimate is proved).\n" \
+ "-E			Grid engine: as -m (with the same heuristic error estimate), but compute each Gram interval's samples together, rotating each term from one to the next.\n" \
+ "-q			Classify first: find the sign of Z at each Gram point, and sample only the intervals next to a bad Gram point (not with -w).\n" \
+ "-Z [positive integer]	Locate each zero crossing to within 10^-Z in 't' (1 to 60, and no more than the -b bits support), sharing the zeros among the -w worker threads.\n" \
  "-h			Show command line parameters.  All other parameters will be ignored.\n" \
- "-s			Report the total seconds taken to compute the Hardy Z values.\n"\
+ "-s			Report the total seconds taken to compute the Hardy Z values, then the time taken by each phase.\n"\
+ "-J			Report the -s phase times and Hardy Z evaluation counts as one line of JSON.\n"\
+ "-O			Write the report from a writer thread, so each window's report is formatted and written while the next is computed.\n"\
  "-v			Verbose report (provides additional useful information -- highly recommended)."; 
 
 const char sCopyright[] = "Copyright 2025-2026 by Terrence P. Murphy." \
@@ -72,9 +95,38 @@ tur.DebugFlags	= 2311; // (2 * 3 * 5 * 7 * 11) + 1
 tur.OutputDP 	= 6;
 tur.DefaultBits	= HGT_PRECISION_DEFAULT;
 tur.Threads		= 1;
+tur.Workers		= 1;
+tur.Pin			= false;
+tur.Refine		= 0;
+tur.CkptFile[0]	= '\0';
+tur.Resume		= false;
+tur.BinFile[0]	= '\0';
+tur.CacheFile[0]	= '\0';
+tur.IndexFile[0]	= '\0';
+tur.IndexStride	= 0;
+tur.Mixed		= false;
+tur.Grid		= false;
+tur.Classify	= false;
+tur.ZeroDigits	= 0;
+tur.Rosser		= false;
+tur.BatchFile[0]	= '\0';
+tur.DaemonSocket[0]	= '\0';
+tur.Json		= false;
+tur.AutoBits	= false;
+tur.TBuf[0]		= '\0';
+tur.SweepGram	= 0;
+tur.StartN		= 0;
+tur.Shards		= 0;
+tur.Plan		= false;
+tur.Writer		= false;
 
 // strcpy(tur.incrBuf, "1");
 
+// -------------------------------------------------------------------
+// A long report is many small writes, so stdout gets a large buffer.
+// TuringReport flushes it at the end of each window.
+// -------------------------------------------------------------------
+setvbuf(stdout, NULL, _IOFBF, TUR_STDOUT_BUF);
 fprintf(stderr, "%s", sCopyright);
 if(argc == 1) {
 	printf("%s\n", sUsage);
@@ -82,7 +134,7 @@ if(argc == 1) {
 	}
 opterr = 0; // To prevent _getopt from printing an error message on standard error
 
-while ((c = getopt (argc, argv, "t:g:c:k:p:b:d:hvs")) != -1)
+while ((c = getopt (argc, argv, "t:T:g:G:n:S:c:k:w:a:Z:C:H:I:X:B:f:D:p:b:d:hmEqvrsRJPMO")) != -1)
 	switch (c)
 		{
 		case 'h':
@@ -91,12 +143,89 @@ while ((c = getopt (argc, argv, "t:g:c:k:p:b:d:hvs")) != -1)
 //			int64_t		i64;
 //			printf("Sizeof intmax_t: %zu, Sizeof int64_t: %zu", sizeof(iMax), sizeof(i64));
 			exit(EXIT_SUCCESS);
+		case 'R':
+			tur.Rosser = true;
+			break;
+		case 'm':
+			tur.Mixed = true;
+			break;
+		case 'E':
+			tur.Grid = true;
+			tur.Mixed = true;
+			break;
+		case 'q':
+			tur.Classify = true;
+			break;
+		case 'M':
+			tur.Plan = true;
+			break;
+		case 'O':
+			tur.Writer = true;
+			break;
+		case 'P':
+			tur.Pin = true;
+			break;
+		case 'r':
+			tur.Resume = true;
+			break;
+		case 'C':
+			if(strlen(optarg) >= TUR_PATH_MAX - 1) {
+				printf("Invalid argument to -C \n");
+				return(EXIT_FAILURE);
+				}
+			strcpy(tur.CkptFile, optarg);
+			break;
+		case 'B':
+			if(strlen(optarg) >= TUR_PATH_MAX - 1) {
+				printf("Invalid argument to -B \n");
+				return(EXIT_FAILURE);
+				}
+			strcpy(tur.BinFile, optarg);
+			break;
+		case 'H':
+			if(strlen(optarg) >= TUR_PATH_MAX - 1) {
+				printf("Invalid argument to -H \n");
+				return(EXIT_FAILURE);
+				}
+			strcpy(tur.CacheFile, optarg);
+			break;
+		case 'I':
+			if(strlen(optarg) >= TUR_PATH_MAX - 1) {
+				printf("Invalid argument to -I \n");
+				return(EXIT_FAILURE);
+				}
+			strcpy(tur.IndexFile, optarg);
+			break;
+		case 'X':
+			tur.IndexStride = ValidateSweepCount(optarg);
+			if(tur.IndexStride < 1 || tur.IndexStride > TUR_INDEX_STRIDE_MAX){
+				printf("Invalid argument to -X \n");
+				return(EXIT_FAILURE);
+				}
+			break;
+		case 'f':
+			if(strlen(optarg) >= TUR_PATH_MAX - 1) {
+				printf("Invalid argument to -f \n");
+				return(EXIT_FAILURE);
+				}
+			strcpy(tur.BatchFile, optarg);
+			break;
+		case 'D':
+			if(strlen(optarg) >= TUR_PATH_MAX - 1) {
+				printf("Invalid argument to -D \n");
+				return(EXIT_FAILURE);
+				}
+			strcpy(tur.DaemonSocket, optarg);
+			break;
 		case 'v':
 			tur.Verbose = true;
 			break;
 		case 's':
 			tur.ShowSeconds = true;
 			break;			
+		case 'J':
+			tur.Json = true;
+			break;			
 		case 't':
 			if (ValidateHardyT (optarg) < 1) {
 				printf("Invalid argument to -t \n");
@@ -105,6 +234,34 @@ while ((c = getopt (argc, argv, "t:g:c:k:p:b:d:hvs")) != -1)
 			strcpy(tur.tBuf, optarg);
 			tDecimalDigits =  GetDecimalDigits(tur.tBuf);
 			break;
+		case 'T':
+			if (ValidateHardyT (optarg) < 1) {
+				printf("Invalid argument to -T \n");
+				return(EXIT_FAILURE);
+				}
+			strcpy(tur.TBuf, optarg);
+			break;
+		case 'G':
+			tur.SweepGram = ValidateSweepCount(optarg);
+			if(tur.SweepGram < 1){
+				printf("Invalid argument to -G \n");
+				return(EXIT_FAILURE);
+				}
+			break;
+		case 'n':
+			tur.StartN = ValidateSweepCount(optarg);
+			if(tur.StartN < 1){
+				printf("Invalid argument to -n \n");
+				return(EXIT_FAILURE);
+				}
+			break;
+		case 'S':
+			tur.Shards = ValidateRange(optarg, 1, TUR_SHARDS_MAX);
+			if(tur.Shards < 1){
+				printf("Invalid argument to -S \n");
+				return(EXIT_FAILURE);
+				}
+			break;
 		case 'g':
 			tur.CountGram = ValidateTuringGramPoints(optarg);
 			if(tur.CountGram < 1){
@@ -120,12 +277,41 @@ while ((c = getopt (argc, argv, "t:g:c:k:p:b:d:hvs")) != -1)
 				}
 			break;
 		case 'k':
+			if(strcmp(optarg, "auto") == 0) {
+				tur.Threads = 0;
+				break;
+				}
 			tur.Threads = ValidateThreads(optarg);	
 			if(tur.Threads < 1){
 				printf("Invalid argument to -k \n");
 				return(EXIT_FAILURE);
 				}
 			break;	
+		case 'w':
+			if(strcmp(optarg, "auto") == 0) {
+				tur.Workers = 0;
+				break;
+				}
+			tur.Workers = ValidateRange(optarg, 1, TUR_WORKERS_MAX);	
+			if(tur.Workers < 1){
+				printf("Invalid argument to -w \n");
+				return(EXIT_FAILURE);
+				}
+			break;	
+		case 'a':
+			tur.Refine = ValidateRange(optarg, 1, TUR_REFINE_MAX);	
+			if(tur.Refine < 1){
+				printf("Invalid argument to -a \n");
+				return(EXIT_FAILURE);
+				}
+			break;	
+		case 'Z':
+			tur.ZeroDigits = ValidateRange(optarg, 1, TUR_ZERO_DIGITS_MAX);	
+			if(tur.ZeroDigits < 1){
+				printf("Invalid argument to -Z \n");
+				return(EXIT_FAILURE);
+				}
+			break;	
 		case 'd':
 			tur.DebugFlags = ValidateDebugFlags(optarg);	
 			if( tur.DebugFlags < 1){
@@ -141,6 +327,10 @@ while ((c = getopt (argc, argv, "t:g:c:k:p:b:d:hvs")) != -1)
 				}
 			break;
 		case 'b':
+			if(strcmp(optarg, "auto") == 0) {
+				tur.AutoBits = true;
+				break;
+				}
 			tur.DefaultBits = ValidatePrecisionMPFR(optarg);	
 			if(tur.DefaultBits < 1) {
 				printf("Invalid argument to -b \n");
@@ -153,24 +343,168 @@ while ((c = getopt (argc, argv, "t:g:c:k:p:b:d:hvs")) != -1)
 			printf("Option -%c is either unknown or missing its argument\n", optopt);
 			return (EXIT_FAILURE);
 		}
-if(tDecimalDigits == -1) {
-	printf("The t parameter is required.\n");
+// -------------------------------------------------------------------
+// With -n, 't' is only needed for -b auto and the checkpoint, so we
+// take it as g(n).
+// -------------------------------------------------------------------
+if(tur.StartN > 0 && tDecimalDigits != -1) {
+	printf("Please use either -t or -n, but not both.\n");
+	return(EXIT_FAILURE);
+	}
+if(tur.StartN > 0) {
+	snprintf(tur.tBuf, sizeof(tur.tBuf), "%.6f", GramApprox(tur.StartN));
+	tDecimalDigits = 0;
+	}
+if(tur.DaemonSocket[0] != '\0') {
+	if(tur.BatchFile[0] != '\0' || tur.TBuf[0] != '\0' || tur.SweepGram > 0 || tur.CkptFile[0] != '\0' 
+		|| tur.Resume == true || tur.BinFile[0] != '\0' || tur.StartN > 0 || tur.Shards > 0 
+		|| tur.IndexStride > 0 || tDecimalDigits != -1) {
+		printf("The -t, -T, -G, -n, -C, -r, -B, -S, -X and -f parameters cannot be used with -D (-t and the rest go in each request).\n");
+		return(EXIT_FAILURE);
+		}
+	if(tur.AutoBits == true) {
+		printf("The -b auto parameter cannot be used with -D (the bits are set once, for every request).\n");
+		return(EXIT_FAILURE);
+		}
+	}
+else if(tur.BatchFile[0] != '\0') {
+	if(tur.TBuf[0] != '\0' || tur.CkptFile[0] != '\0' || tur.Resume == true 
+		|| tur.BinFile[0] != '\0' || tur.StartN > 0 || tur.Shards > 0 || tur.IndexStride > 0) {
+		printf("The -T, -C, -r, -B, -n, -S and -X parameters cannot be used with -f.\n");
+		return(EXIT_FAILURE);
+		}
+	}
+else if(tDecimalDigits == -1) {
+	printf("The t (or n) parameter is required.\n");
 	return(EXIT_FAILURE);
 	}
 else if(tDecimalDigits > tur.OutputDP) {
 	tur.OutputDP	= tDecimalDigits;
 	}
+if(tur.TBuf[0] != '\0' && tur.SweepGram > 0) {
+	printf("Please use either -T or -G, but not both.\n");
+	return(EXIT_FAILURE);
+	}
+if(tur.Classify == true && tur.Workers != 1 && tur.DaemonSocket[0] == '\0') {
+	printf("The -w parameter cannot be used with -q (which samples the unsettled Gram intervals one at a time).\n");
+	return(EXIT_FAILURE);
+	}
+if(tur.Workers > tur.CountGram + 2 && tur.BatchFile[0] == '\0' && tur.DaemonSocket[0] == '\0') {
+	printf("The -w value must be at most %d at -g %d (a window has at most -g + 2 tasks for the workers to share).\n",
+		tur.CountGram + 2, tur.CountGram);
+	return(EXIT_FAILURE);
+	}
+if(tur.Classify == true && tur.BinFile[0] != '\0') {
+	printf("The -B parameter cannot be used with -q (which does not compute every sample).\n");
+	return(EXIT_FAILURE);
+	}
+if(tur.Plan == true && (tur.BatchFile[0] != '\0' || tur.DaemonSocket[0] != '\0' 
+	|| tur.Shards > 0 || tur.IndexStride > 0 || tur.Resume == true)) {
+	printf("The -M parameter cannot be used with -f, -D, -S, -X or -r.\n");
+	return(EXIT_FAILURE);
+	}
+if(tur.Resume == true && tur.CkptFile[0] == '\0') {
+	printf("The -r parameter requires -C (the checkpoint file).\n");
+	return(EXIT_FAILURE);
+	}
+if(tur.TBuf[0] != '\0' && strtod(tur.TBuf, NULL) < strtod(tur.tBuf, NULL)) {
+	printf("The -T value must not be less than the -t value.\n");
+	return(EXIT_FAILURE);
+	}
+
+// -------------------------------------------------------------------
+// With -b auto, the bits are chosen from the largest 't' we will see,
+// at the end of a -T or -G sweep (in batch mode, that is done when the
+// batch file is read).
+// -------------------------------------------------------------------
+if(tur.AutoBits == true && tur.BatchFile[0] == '\0') {
+	tur.DefaultBits = AutoPrecision(tur.tBuf, AutoEnd(tur));
+	printf("MPFR precision (-b auto): %d bits \n\n", tur.DefaultBits);
+	}
+
+// -------------------------------------------------------------------
+// -Z cannot locate a zero to more digits than the bits support (in
+// batch and daemon mode, that is checked for each job).
+// -------------------------------------------------------------------
+if(tur.ZeroDigits > 0 && tur.BatchFile[0] == '\0' && tur.DaemonSocket[0] == '\0'
+	&& tur.ZeroDigits > ZeroDigitsMax(tur.DefaultBits, AutoEnd(tur))) {
+	printf("The -Z value must be at most %d at -b %d for this 't' (more digits than that need more bits).\n",
+		ZeroDigitsMax(tur.DefaultBits, AutoEnd(tur)), tur.DefaultBits);
+	return(EXIT_FAILURE);
+	}
+
+// -------------------------------------------------------------------
+// With -k auto and/or -w auto, the threads are chosen from the CPUs
+// this process may run on (see CpuAuto).
+// -------------------------------------------------------------------
+if(tur.Threads == 0 || tur.Workers == 0) {
+	CpuAuto(&tur);
+	printf("Threads (-k/-w auto): %d worker threads, %d threads each, on %d CPUs \n\n",
+		tur.Workers, tur.Threads, CpuCount());
+	}
+
+// -------------------------------------------------------------------
+// With -S, we only print the shard plan (the -B value, if any, names
+// the shard files).
+// -------------------------------------------------------------------
+if(tur.Shards > 0) {
+	if(tur.BinFile[0] == '\0') {
+		strcpy(tur.BinFile, "shard");
+		}
+	return(PlanShards(tur) == 1 ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+// -------------------------------------------------------------------
+// With -M, we only print the predicted run time and settings.
+// -------------------------------------------------------------------
+if(tur.Plan == true) {
+	return(PlanRun(tur) == 1 ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+// -------------------------------------------------------------------
+// With -X, we only build the -I Gram point index.
+// -------------------------------------------------------------------
+if(tur.IndexStride > 0) {
+	StatsInit();
+	if(IndexBuild(tur) != 1) {
+		return(EXIT_FAILURE);
+		}
+	if(tur.ShowSeconds == true || tur.Json == true) {
+		StatsReport(tur.Json);
+		}
+	return(EXIT_SUCCESS);
+	}
+
+// -------------------------------------------------------------------
+// With -D, we serve requests until we are signalled.
+// -------------------------------------------------------------------
+if(tur.DaemonSocket[0] != '\0') {
+	StatsInit();
+	return(DaemonServe(tur) == 1 ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
 
 // -------------------------------------------------------------------
 // We have finished validating the command line parameters.  Now compute 
 // and printf our HardyZ results.  Report the time it takes to do the
-// computations if the user enters the -s command line parameter.
+// computations if the user enters the -s command line parameter (and
+// the time taken by each phase, with -s or -J).
 // -------------------------------------------------------------------
 struct timespec start, end;
 double 			time_taken;
 
+// -------------------------------------------------------------------
+// With -P and -w 1, the main thread does all the work, so it is the
+// one pinned (with more workers, PoolHardyZWindow pins each).
+// -------------------------------------------------------------------
+if(tur.Pin == true && tur.Workers <= 1) {
+	CpuPinMain(tur.Threads);
+	}
+
+StatsInit();
 clock_gettime(CLOCK_MONOTONIC, &start);
-ComputeTuring(tur);
+if((tur.BatchFile[0] != '\0' ? ComputeBatch(tur) : ComputeTuring(tur)) < 1) {
+	return(EXIT_FAILURE);
+	}
 clock_gettime(CLOCK_MONOTONIC, &end);
 time_taken =  (end.tv_sec - start.tv_sec);
 time_taken += (end.tv_nsec - start.tv_nsec) / 1000000000.0;
@@ -178,5 +512,113 @@ time_taken += (end.tv_nsec - start.tv_nsec) / 1000000000.0;
 if(tur.ShowSeconds){
 	printf("Compute took %f seconds to execute \n", time_taken); 
 	}
+if(tur.ShowSeconds == true || tur.Json == true) {
+	StatsReport(tur.Json);
+	}
 return(EXIT_SUCCESS);
 }
+
+
+// *******************************************************************
+// We validate the -G (sweep count) command line parameter.  Unlike 
+// -g, there is no upper bound other than what fits in 64 bits. We 
+// return 0 if the parameter is invalid.
+// *******************************************************************
+uint64_t ValidateSweepCount(char *sCount)
+{
+char 		*pEnd;
+
+if(*sCount == '\0' || strlen(sCount) > 18) {
+	return(0);
+	}
+for(pEnd = sCount; *pEnd != '\0'; pEnd++) {
+	if(!isdigit((unsigned char) *pEnd)) {
+		return(0);
+		}
+	}
+return((uint64_t) strtoull(sCount, NULL, 10));
+}
+
+
+// *******************************************************************
+// We validate a command line parameter that must be an integer from
+// Low through High (such as -w and -a).  We return -1 if the 
+// parameter is invalid.
+// *******************************************************************
+int ValidateRange(char *sValue, int Low, int High)
+{
+char 		*pEnd;
+long		Value;
+
+if(*sValue == '\0' || strlen(sValue) > 9) {
+	return(-1);
+	}
+for(pEnd = sValue; *pEnd != '\0'; pEnd++) {
+	if(!isdigit((unsigned char) *pEnd)) {
+		return(-1);
+		}
+	}
+Value = strtol(sValue, NULL, 10);
+return((Value < Low || Value > High) ? -1 : (int) Value);
+}
+
+
+// *******************************************************************
+// With -b auto, we choose the MPFR bits for a run from 't' (as entered
+// on the command line) to tEnd (see AutoEnd).  We need enough bits at
+// the larger of the two for each of:
+//
+// (1) the phases theta(t) - t log n of the Riemann-Siegel main sum.
+// These are of size t log t, and we want them to 64 bits after the
+// binary point, with log2(N) guard bits for the N = sqrt(t/2pi)
+// terms summed, so that every sign decision is safe.
+// (2) the Gram points, which are located to an Accuracy of 0.5e-16
+// (so log2(t) + 55 bits), and
+// (3) 't' itself, with all the digits the user entered.
+//
+// We add 16 guard bits to the largest, round up to a multiple of 64,
+// and keep the result within the 128 to 1024 bits allowed by -b.
+// *******************************************************************
+int AutoPrecision(char *sT, double tEnd)
+{
+double		t, Terms, Bits, Need;
+int			Digits;
+
+t = strtod(sT, NULL);
+t = t > tEnd ? t : tEnd;
+t = t > 10 ? t : 10;
+Terms = sqrt(t / (2 * M_PI));
+
+Bits = log2(t * log(t)) + 64 + log2(Terms > 1 ? Terms : 1);
+Need = log2(t) + 55;
+Bits = Need > Bits ? Need : Bits;
+Digits = (int) strlen(sT) - (strchr(sT, '.') != NULL ? 1 : 0);
+Need = Digits * log2(10);
+Bits = Need > Bits ? Need : Bits;
+
+Bits = 64 * ceil((Bits + 16) / 64);
+Bits = Bits < 128 ? 128 : (Bits > 1024 ? 1024 : Bits);
+return((int) Bits);
+}
+
+
+// *******************************************************************
+// We return the largest 't' of the run, for -b auto: the -T value, or
+// else 't' plus the -G (or -g) Gram intervals, each taken as long as
+// the first one, 2 pi / log(t / 2 pi).  Gram intervals only get
+// shorter as t grows, so this is never too small.  (-R stops within
+// the same range.)
+// *******************************************************************
+double AutoEnd(struct TURING tur)
+{
+double		t, Span;
+uint64_t	Grams;
+
+if(tur.TBuf[0] != '\0') {
+	return(strtod(tur.TBuf, NULL));
+	}
+t = strtod(tur.tBuf, NULL);
+Grams = tur.SweepGram > 0 ? tur.SweepGram : (uint64_t) tur.CountGram;
+Span = 2 * M_PI / log((t > TUR_GRAM_NEXT_MIN ? t : TUR_GRAM_NEXT_MIN) / (2 * M_PI));
+return(t + ((double) Grams * Span));
+}
@@ -0,0 +1,413 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <time.h>
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <mpfr.h>
+#ifndef _WIN32
+#include <semaphore.h>
+#endif
+
+#include "hgt.h"
+#include "turing.h"
+
+#ifndef _WIN32
+#define	TUR_WRITE_TEXT		0		// a block of text, written as is
+#define	TUR_WRITE_REPORT	1		// a window's data, formatted by TuringReport
+#define	TUR_WRITE_DRAIN		2		// post Drained once all before it is written
+#define	TUR_WRITE_STOP		3		// stop the writer
+
+// -------------------------------------------------------------------
+// The computation hands the writer thread a queue of items, through a
+// ring of TUR_WRITER_SLOTS slots with one producer (the computation)
+// and one consumer (the writer).  Each side moves only its own index,
+// and the two semaphores count the full and the empty slots, so that
+// either side sleeps while it must wait; the semaphores also order
+// each slot's contents between the two threads.
+//
+// An item is either a block of text (what the computation writes to
+// ctx->fpOut between reports, built in memory by open_memstream), or
+// a window: a copy of the window's data in one of TUR_WRITER_SNAPS
+// contexts kept for the purpose, which the writer formats with
+// TuringReport (and ZeroReport) and then gives back.
+// -------------------------------------------------------------------
+struct WRITERSLOT {
+	int					Kind;				// TUR_WRITE_xxx
+	char *				Text;				// TUR_WRITE_TEXT
+	size_t				Size;
+	struct TURCTX *		Snap;				// TUR_WRITE_REPORT
+	struct TURING		tur;
+};
+
+struct TURWRITER {
+	pthread_t			Thread;
+	FILE *				fpOut;				// the report stream (stdout, or a -D client's socket)
+	struct WRITERSLOT	Slot[TUR_WRITER_SLOTS];
+	uint64_t			Head;				// items handed over (moved by the computation only)
+	uint64_t			Tail;				// items taken (moved by the writer only)
+	sem_t				Full;				// slots holding an item
+	sem_t				Empty;				// slots free
+	struct TURCTX *		Snap[TUR_WRITER_SNAPS];
+	uint64_t			SnapNext;			// the next Snap to fill (they come back in order)
+	sem_t				SnapFree;			// Snap contexts free
+	sem_t				Drained;			// posted for each TUR_WRITE_DRAIN
+	char *				Block;				// the block being built (see open_memstream)
+	size_t				BlockSize;
+	uint64_t			Reports;
+	uint64_t			Blocks;
+	uint64_t			Bytes;
+	double				Waited;				// seconds the computation waited for the writer
+};
+
+static void *	WriterThread(void *pArg);
+static int		WriterBlock(struct TURCTX *ctx);
+static int		WriterHand(struct TURWRITER *w, int Kind, char *Text, size_t Size,
+					struct TURCTX *Snap, struct TURING *pTur);
+static int		WriterCopy(struct TURCTX *Snap, struct TURCTX *ctx, struct TURING tur);
+static int		WriterSet(mpfr_t Dst, mpfr_t Src);
+static int		WriterWait(struct TURWRITER *w, sem_t *pSem);
+static int		WriterFree(struct TURWRITER *w);
+#endif
+
+
+// *******************************************************************
+// With -O, the report goes through a writer thread, so that each
+// window's report is formatted and written while the next window is
+// computed.  We start the writer, and point ctx->fpOut at a block in
+// memory.  We return 0 (and the report is written directly, as
+// without -O) if we cannot.
+// *******************************************************************
+int WriterOpen(struct TURCTX *ctx)
+{
+#ifdef _WIN32
+fprintf(stderr, "The -O writer thread is not available on Windows; writing the report directly \n");
+(void) ctx;
+return(0);
+#else
+struct TURWRITER *	w;
+FILE *				fp = NULL;
+int					i, Ok;
+
+if((w = calloc(1, sizeof(struct TURWRITER))) == NULL) {
+	fprintf(stderr, "Unable to set up the -O writer thread; writing the report directly \n");
+	return(0);
+	}
+w->fpOut = ctx->fpOut;
+sem_init(&w->Full, 0, 0);
+sem_init(&w->Empty, 0, TUR_WRITER_SLOTS);
+sem_init(&w->SnapFree, 0, TUR_WRITER_SNAPS);
+sem_init(&w->Drained, 0, 0);
+Ok = true;
+for(i=0; i < TUR_WRITER_SNAPS && Ok == true; i++) {
+	if((w->Snap[i] = TuringCtxNew(ctx->MaxGram, ctx->MaxCountZ)) == NULL) {
+		Ok = false;
+		}
+	else {
+		w->Snap[i]->fpOut = w->fpOut;
+		}
+	}
+if(Ok == false || (fp = open_memstream(&w->Block, &w->BlockSize)) == NULL) {
+	fprintf(stderr, "Unable to set up the -O writer thread; writing the report directly \n");
+	WriterFree(w);
+	return(0);
+	}
+if(pthread_create(&w->Thread, NULL, WriterThread, w) != 0) {
+	fprintf(stderr, "Unable to start the -O writer thread; writing the report directly \n");
+	fclose(fp);
+	free(w->Block);
+	WriterFree(w);
+	return(0);
+	}
+ctx->Writer = w;
+ctx->fpOut = fp;
+return(1);
+#endif
+}
+
+
+// *******************************************************************
+// In place of TuringReport (and ZeroReport), we hand the writer the
+// text so far and a copy of the window's data, which it formats.  We
+// return 0 if there is no writer (the caller then reports directly).
+// *******************************************************************
+int WriterReport(struct TURCTX *ctx, struct TURING tur)
+{
+#ifdef _WIN32
+(void) ctx;
+(void) tur;
+return(0);
+#else
+struct TURWRITER *	w = ctx->Writer;
+struct TURCTX *		Snap;
+
+if(w == NULL || WriterBlock(ctx) == 0) {
+	return(0);
+	}
+WriterWait(w, &w->SnapFree);
+Snap = w->Snap[w->SnapNext % TUR_WRITER_SNAPS];
+w->SnapNext += 1;
+WriterCopy(Snap, ctx, tur);
+WriterHand(w, TUR_WRITE_REPORT, NULL, 0, Snap, &tur);
+return(1);
+#endif
+}
+
+
+// *******************************************************************
+// At the end of each window, we hand the writer the text written
+// since its report.  With Drain, we also wait until the writer has
+// written everything (so that a checkpoint never gets ahead of the
+// report).
+// *******************************************************************
+int WriterPush(struct TURCTX *ctx, bool Drain)
+{
+#ifdef _WIN32
+(void) ctx;
+(void) Drain;
+return(0);
+#else
+struct TURWRITER *	w = ctx->Writer;
+
+if(w == NULL || WriterBlock(ctx) == 0) {
+	return(0);
+	}
+if(Drain == true) {
+	WriterHand(w, TUR_WRITE_DRAIN, NULL, 0, NULL, NULL);
+	WriterWait(w, &w->Drained);
+	}
+return(1);
+#endif
+}
+
+
+// *******************************************************************
+// We hand over the last block, stop the writer once it has written
+// everything, and point ctx->fpOut back at the report stream.
+// *******************************************************************
+int WriterClose(struct TURCTX *ctx)
+{
+#ifdef _WIN32
+(void) ctx;
+return(0);
+#else
+struct TURWRITER *	w = ctx->Writer;
+
+if(w == NULL) {
+	return(0);
+	}
+if(ctx->fpOut != w->fpOut) {
+	fclose(ctx->fpOut);
+	if(w->BlockSize > 0) {
+		WriterHand(w, TUR_WRITE_TEXT, w->Block, w->BlockSize, NULL, NULL);
+		}
+	else {
+		free(w->Block);
+		}
+	}
+WriterHand(w, TUR_WRITE_STOP, NULL, 0, NULL, NULL);
+pthread_join(w->Thread, NULL);
+ctx->fpOut = w->fpOut;
+fprintf(ctx->fpOut, "Writer thread: %ju window reports formatted, %ju text blocks (%ju bytes), the computation waited %.3f seconds for it \n",
+	(uintmax_t) w->Reports, (uintmax_t) w->Blocks, (uintmax_t) w->Bytes, w->Waited);
+fflush(ctx->fpOut);
+WriterFree(w);
+ctx->Writer = NULL;
+return(1);
+#endif
+}
+
+
+#ifndef _WIN32
+// *******************************************************************
+// We hand the writer the block being built (if it holds anything),
+// and start the next.  We return 0 if we cannot start the next block
+// (the writer is then closed, and the report written directly).
+// *******************************************************************
+static int WriterBlock(struct TURCTX *ctx)
+{
+struct TURWRITER *	w = ctx->Writer;
+
+fclose(ctx->fpOut);
+if(w->BlockSize > 0) {
+	WriterHand(w, TUR_WRITE_TEXT, w->Block, w->BlockSize, NULL, NULL);
+	}
+else {
+	free(w->Block);
+	}
+w->Block = NULL;
+w->BlockSize = 0;
+if((ctx->fpOut = open_memstream(&w->Block, &w->BlockSize)) == NULL) {
+	fprintf(stderr, "Unable to continue the -O writer thread; writing the report directly \n");
+	ctx->fpOut = w->fpOut;
+	WriterClose(ctx);
+	return(0);
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// We put an item in the next slot, waiting for one to be free.
+// *******************************************************************
+static int WriterHand(struct TURWRITER *w, int Kind, char *Text, size_t Size,
+	struct TURCTX *Snap, struct TURING *pTur)
+{
+struct WRITERSLOT *	s;
+
+WriterWait(w, &w->Empty);
+s = &w->Slot[w->Head % TUR_WRITER_SLOTS];
+s->Kind = Kind;
+s->Text = Text;
+s->Size = Size;
+s->Snap = Snap;
+if(pTur != NULL) {
+	s->tur = *pTur;
+	}
+w->Head += 1;
+sem_post(&w->Full);
+return(1);
+}
+
+
+// *******************************************************************
+// We copy what TuringReport and ZeroReport read of the window into
+// Snap: the Gram points, the samples and their 't' text, and the
+// located zeros.
+// *******************************************************************
+static int WriterCopy(struct TURCTX *Snap, struct TURCTX *ctx, struct TURING tur)
+{
+int		i, hzNum;
+
+hzNum = (tur.CountGram * ctx->CountZ) + 2;
+Snap->CountZ = ctx->CountZ;
+WriterSet(Snap->tBefore, ctx->tBefore);
+for(i=0; i <= tur.CountGram; i++) {
+	WriterSet(Snap->gList[i].Gram, ctx->gList[i].Gram);
+	WriterSet(Snap->gList[i].n, ctx->gList[i].n);
+	WriterSet(Snap->gList[i].lenInterval, ctx->gList[i].lenInterval);
+	WriterSet(Snap->gList[i].lenSubInterval, ctx->gList[i].lenSubInterval);
+	Snap->gList[i].MinusOneToN	= ctx->gList[i].MinusOneToN;
+	Snap->gList[i].Good			= ctx->gList[i].Good;
+	Snap->gList[i].OddZeros		= ctx->gList[i].OddZeros;
+	Snap->gList[i].Settled		= ctx->gList[i].Settled;
+	Snap->gList[i].ZerosFound	= ctx->gList[i].ZerosFound;
+	Snap->gList[i].GridBound	= ctx->gList[i].GridBound;
+	}
+memcpy(Snap->hInfo, ctx->hInfo, hzNum * sizeof(struct HARDYINFO));
+memcpy(Snap->tText, ctx->tText, (size_t) hzNum * TUR_T_TEXT_MAX);
+
+Snap->ZeroCount = 0;
+if(tur.ZeroDigits > 0 && ctx->ZeroCount > 0 && ZeroAlloc(Snap) == 1) {
+	for(i=0; i < ctx->ZeroCount; i++) {
+		Snap->Zeros[i].kLo		= ctx->Zeros[i].kLo;
+		Snap->Zeros[i].kHi		= ctx->Zeros[i].kHi;
+		Snap->Zeros[i].Evals	= ctx->Zeros[i].Evals;
+		Snap->Zeros[i].Ok		= ctx->Zeros[i].Ok;
+		WriterSet(Snap->Zeros[i].t, ctx->Zeros[i].t);
+		}
+	Snap->ZeroCount = ctx->ZeroCount;
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// An exact copy (a batch job may have changed the precision since
+// the Snap contexts were set up).
+// *******************************************************************
+static int WriterSet(mpfr_t Dst, mpfr_t Src)
+{
+mpfr_set_prec (Dst, mpfr_get_prec(Src));
+mpfr_set (Dst, Src, MPFR_RNDN);
+return(1);
+}
+
+
+// *******************************************************************
+// The writer: each item in turn, until TUR_WRITE_STOP.
+// *******************************************************************
+static void * WriterThread(void *pArg)
+{
+struct TURWRITER *	w = pArg;
+struct WRITERSLOT	Item;
+
+for(;;) {
+	while(sem_wait(&w->Full) != 0)
+		;
+	Item = w->Slot[w->Tail % TUR_WRITER_SLOTS];
+	w->Tail += 1;
+	sem_post(&w->Empty);
+	if(Item.Kind == TUR_WRITE_STOP) {
+		break;
+		}
+	if(Item.Kind == TUR_WRITE_TEXT) {
+		fwrite(Item.Text, 1, Item.Size, w->fpOut);
+		fflush(w->fpOut);
+		w->Blocks += 1;
+		w->Bytes += Item.Size;
+		free(Item.Text);
+		}
+	else if(Item.Kind == TUR_WRITE_REPORT) {
+		TuringReport(Item.Snap, Item.tur);
+		if(Item.tur.ZeroDigits > 0) {
+			ZeroReport(Item.Snap, Item.tur);
+			fflush(w->fpOut);
+			}
+		w->Reports += 1;
+		sem_post(&w->SnapFree);
+		}
+	else {
+		sem_post(&w->Drained);
+		}
+	}
+return(NULL);
+}
+
+
+// *******************************************************************
+// The computation waits on one of the writer's semaphores, and we
+// count the time as time spent waiting for the writer.
+// *******************************************************************
+static int WriterWait(struct TURWRITER *w, sem_t *pSem)
+{
+struct timespec		Start, End;
+
+if(sem_trywait(pSem) == 0) {
+	return(1);
+	}
+clock_gettime(CLOCK_MONOTONIC, &Start);
+while(sem_wait(pSem) != 0)
+	;
+clock_gettime(CLOCK_MONOTONIC, &End);
+w->Waited += (double) (End.tv_sec - Start.tv_sec)
+	+ ((double) (End.tv_nsec - Start.tv_nsec) / 1000000000.0);
+return(1);
+}
+
+
+static int WriterFree(struct TURWRITER *w)
+{
+int		i;
+
+for(i=0; i < TUR_WRITER_SNAPS; i++) {
+	if(w->Snap[i] != NULL) {
+		TuringCtxFree(w->Snap[i]);
+		}
+	}
+sem_destroy(&w->Full);
+sem_destroy(&w->Empty);
+sem_destroy(&w->SnapFree);
+sem_destroy(&w->Drained);
+free(w);
+return(1);
+}
+#endif
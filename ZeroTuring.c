@@ -0,0 +1,275 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+
+extern struct	HGT_INIT	hgt_init;
+
+struct ZEROPOOL {
+	struct TURCTX *		ctx;
+	struct TURING		tur;
+	pthread_mutex_t		Lock;
+	int					Next;			// next bracket to take
+};
+
+static void *	ZeroWorker(void *pArg);
+static int		ZeroIllinois(struct TURCTX *ctx, struct TURING tur, int z);
+static double	ZeroEval(struct TURCTX *ctx, int z, mpfr_t t);
+
+
+// *******************************************************************
+// With -Z, we locate each zero crossing found in the window (a sign
+// change between two neighbouring samples) to within 10^-Z in 't'.
+// Each bracket is narrowed by the Illinois method (regula falsi, with
+// the stale end's Hardy Z halved whenever the same end is kept twice
+// running), which typically needs only a handful of Hardy Z values
+// per zero.  The brackets are shared out among the -w worker threads.
+//
+// In a -q settled interval (see ClassHardyZWindow), the bracket is
+// the whole Gram interval.  Crossings found by -a refinement are
+// counted, but not located.
+// *******************************************************************
+int ZeroWindow(struct TURCTX *ctx, struct TURING tur)
+{
+pthread_t			Thread[TUR_WORKERS_MAX];
+struct ZEROPOOL		Pool;
+int					i, j, k, Threads;
+
+if(ZeroAlloc(ctx) == 0) {
+	return(0);
+	}
+
+// -------------------------------------------------------------------
+// Collect the brackets: the sample that ends each one is k, and it
+// begins at sample k - 1 (or, -q settled, at the Gram point).
+// -------------------------------------------------------------------
+ctx->ZeroCount = 0;
+for(i=0; i < tur.CountGram; i++) {
+	for(j = 0; j < ctx->CountZ; j++) {
+		k = (i * ctx->CountZ) + 2 + j;
+		if(ctx->hInfo[k].ZeroCross == false || ctx->hInfo[k].RefineZeros > 0) {
+			continue;
+			}
+		ctx->Zeros[ctx->ZeroCount].kHi  = k;
+		ctx->Zeros[ctx->ZeroCount].kLo  = (tur.Classify == true && ctx->gList[i].Settled == true)
+			? (i * ctx->CountZ) + 1 : k - 1;
+		ctx->ZeroCount++;
+		}
+	}
+
+Pool.ctx  = ctx;
+Pool.tur  = tur;
+Pool.Next = 0;
+pthread_mutex_init(&Pool.Lock, NULL);
+Threads = tur.Workers < ctx->ZeroCount ? tur.Workers : ctx->ZeroCount;
+for(i=1; i < Threads; i++) {
+	pthread_create(&Thread[i], NULL, ZeroWorker, &Pool);
+	}
+ZeroWorker(&Pool);
+for(i=1; i < Threads; i++) {
+	pthread_join(Thread[i], NULL);
+	}
+pthread_mutex_destroy(&Pool.Lock);
+
+for(i=0; i < ctx->ZeroCount; i++) {
+	ctx->sweep.ZeroLocated += ctx->Zeros[i].Ok == true ? 1 : 0;
+	ctx->sweep.ZeroEvals += ctx->Zeros[i].Evals;
+	}
+return(ctx->ZeroCount);
+}
+
+
+// *******************************************************************
+// The first time through, we set up room for a bracket per sample.
+// *******************************************************************
+int ZeroAlloc(struct TURCTX *ctx)
+{
+int		k;
+
+if(ctx->Zeros != NULL) {
+	return(1);
+	}
+if((ctx->Zeros = calloc((ctx->MaxGram * ctx->MaxCountZ) + 2, sizeof(struct TURZERO))) == NULL) {
+	fprintf(stderr, "Unable to allocate the -Z brackets \n");
+	return(0);
+	}
+for(k=0; k < (ctx->MaxGram * ctx->MaxCountZ) + 2; k++) {
+	mpfr_init2 (ctx->Zeros[k].t, hgt_init.DefaultBits);
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// Each worker takes the next bracket until none are left.
+// *******************************************************************
+static void * ZeroWorker(void *pArg)
+{
+struct ZEROPOOL *	pPool = (struct ZEROPOOL *) pArg;
+int					z;
+
+while(true) {
+	pthread_mutex_lock(&pPool->Lock);
+	z = pPool->Next++;
+	pthread_mutex_unlock(&pPool->Lock);
+	if(z >= pPool->ctx->ZeroCount) {
+		break;
+		}
+	ZeroIllinois(pPool->ctx, pPool->tur, z);
+	}
+return(NULL);
+}
+
+
+// *******************************************************************
+// We narrow bracket z until it is no wider than 10^-ZeroDigits (or Z
+// is exactly 0), and leave the zero in Zeros[z].t.  Hardy Z is kept
+// as a double, which is all the secant step needs; 't' itself is in
+// MPFR.  We return 0 if we run out of steps.
+// *******************************************************************
+static int ZeroIllinois(struct TURCTX *ctx, struct TURING tur, int z)
+{
+struct TURZERO *	pZero = &ctx->Zeros[z];
+mpfr_t				a, b, Tol, Width;
+double				fa, fb, fc;
+int					Step, Side = 0;
+
+mpfr_inits2 (hgt_init.DefaultBits, a, b, Tol, Width, (mpfr_ptr) 0);
+HardyT(ctx, a, tur, pZero->kLo);
+HardyT(ctx, b, tur, pZero->kHi);
+fa = ctx->hInfo[pZero->kLo].hzValue;
+fb = ctx->hInfo[pZero->kHi].hzValue;
+mpfr_set_ui (Tol, 10, MPFR_RNDN);
+mpfr_pow_si (Tol, Tol, -tur.ZeroDigits, MPFR_RNDN);
+pZero->Evals = 0;
+pZero->Ok = false;
+
+for(Step = 0; Step < TUR_ZERO_STEPS; Step++) {
+	mpfr_sub (Width, b, a, MPFR_RNDN);
+	if(mpfr_cmpabs (Width, Tol) <= 0) {
+		pZero->Ok = true;
+		break;
+		}
+
+	// -------------------------------------------------------------------
+	// c = b - fb (b - a) / (fb - fa), which lies strictly inside [a, b]
+	// since fa and fb differ in sign.
+	// -------------------------------------------------------------------
+	mpfr_mul_d (Width, Width, fb / (fb - fa), MPFR_RNDN);
+	mpfr_sub (pZero->t, b, Width, MPFR_RNDN);
+	fc = ZeroEval(ctx, z, pZero->t);
+	pZero->Evals += 1;
+	if(fc == 0) {
+		mpfr_set (a, pZero->t, MPFR_RNDN);
+		mpfr_set (b, pZero->t, MPFR_RNDN);
+		pZero->Ok = true;
+		break;
+		}
+	if(fc * fb < 0) {
+		mpfr_set (a, b, MPFR_RNDN);
+		fa = fb;
+		Side = 0;
+		}
+	else {
+		fa = Side == 1 ? fa / 2 : fa;		// Illinois: the same end kept twice
+		Side = 1;
+		}
+	mpfr_set (b, pZero->t, MPFR_RNDN);
+	fb = fc;
+	}
+
+// -------------------------------------------------------------------
+// The zero is in [min(a, b), max(a, b)]; we report its midpoint.
+// -------------------------------------------------------------------
+mpfr_add (pZero->t, a, b, MPFR_RNDN);
+mpfr_div_ui (pZero->t, pZero->t, 2, MPFR_RNDN);
+mpfr_clears (a, b, Tol, Width, (mpfr_ptr) 0);
+return(pZero->Ok == true ? 1 : 0);
+}
+
+
+static double ZeroEval(struct TURCTX *ctx, int z, mpfr_t t)
+{
+mpfr_t	One;
+
+mpfr_inits2 (hgt_init.DefaultBits, One, (mpfr_ptr) 0);
+mpfr_set_ui (One, 1, MPFR_RNDN);
+TimedHardyZ(t, One, 1, TUR_CALLER(ctx, z), HardyZCallbackZ);
+mpfr_clears (One, (mpfr_ptr) 0);
+return(ctx->Zeros[z].hzValue);
+}
+
+
+// *******************************************************************
+// We list the zeros located in the window, each with the sample that
+// ends its bracket (the report's G(i) j row marked "Crossing").
+// *******************************************************************
+int ZeroReport(struct TURCTX *ctx, struct TURING tur)
+{
+int		z, Digits;
+
+Digits = tur.ZeroDigits > tur.OutputDP ? tur.ZeroDigits : tur.OutputDP;
+fprintf(ctx->fpOut, "\nZeros located (to within 1e-%d):\n\n", tur.ZeroDigits);
+for(z = 0; z < ctx->ZeroCount; z++) {
+	mpfr_fprintf(ctx->fpOut, "Z(%2d) %2d, %.*Rf, %2d Hardy Z values%s \n", (ctx->Zeros[z].kHi - 1) / ctx->CountZ,
+		(ctx->Zeros[z].kHi - 1) % ctx->CountZ, Digits, ctx->Zeros[z].t, ctx->Zeros[z].Evals,
+		ctx->Zeros[z].Ok == true ? "" : " (not converged)");
+	}
+return(1);
+}
+
+
+// *******************************************************************
+// We return the most digits -Z can locate a zero to at the given bits,
+// up to 't'.  As in AutoPrecision, Hardy Z is good only to about
+// Bits - log2(t log t) - log2(sqrt(t / 2 pi)) bits, as its phases are
+// of size t log t and sqrt(t / 2 pi) terms are summed.  Past that,
+// the sign of Z near a zero is noise and the bracket cannot narrow.
+// We keep 16 of those bits as guard bits.
+// *******************************************************************
+int ZeroDigitsMax(int Bits, double t)
+{
+double	Good, Terms;
+
+t = t > 10 ? t : 10;
+Terms = sqrt(t / (2 * M_PI));
+Good = Bits - log2(t * log(t)) - log2(Terms > 1 ? Terms : 1) - 16;
+Good = floor(Good * log10(2));
+return(Good < 0 ? 0 : (Good > TUR_ZERO_DIGITS_MAX ? TUR_ZERO_DIGITS_MAX : (int) Good));
+}
+
+
+// *******************************************************************
+// The callback used by HardyZWithCount while locating zeros.  Here
+// the low bits of CallerID are the bracket number.
+// *******************************************************************
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+int HardyZCallbackZ(mpfr_t t, mpfr_t HardyZ, int i, int CallerID)
+{
+struct TURCTX *	ctx = TuringCtxOf(CallerID);
+ctx->Zeros[CallerID & TUR_CTX_MASK].hzValue = mpfr_get_d (HardyZ, MPFR_RNDN);
+return(1);
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+#pragma GCC diagnostic pop
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -0,0 +1,40 @@
+#!/bin/sh
+# -------------------------------------------------------------------
+# Compare the throughput (jobs per second) of batch mode (-f) with a
+# separate turing process for each 't' value.  The 't' values are
+# spread out from a starting 't', as in a check of scattered regions.
+#
+# Usage: bench/batch.sh [first t] [jobs] [g] [c]
+# -------------------------------------------------------------------
+TURING=${TURING:-./turing}
+T=${1:-1000000}
+JOBS=${2:-50}
+G=${3:-2}
+C=${4:-8}
+LIST=$(mktemp)
+trap 'rm -f "$LIST"' EXIT
+
+j=0
+while [ $j -lt "$JOBS" ]; do
+	echo "$((T + (j * 997))).25" >> "$LIST"
+	j=$((j + 1))
+done
+
+now() {
+	date +%s.%N
+}
+
+echo "$JOBS jobs from t = $T, -g $G, -c $C"
+start=$(now)
+while read -r t; do
+	"$TURING" -t "$t" -g "$G" -c "$C" > /dev/null 2>&1
+done < "$LIST"
+end=$(now)
+awk -v s="$start" -v e="$end" -v n="$JOBS" \
+	'BEGIN { printf "%-12s %10.3f seconds %10.2f jobs/sec\n", "processes", e - s, n / (e - s) }'
+
+start=$(now)
+"$TURING" -f "$LIST" -g "$G" -c "$C" > /dev/null 2>&1
+end=$(now)
+awk -v s="$start" -v e="$end" -v n="$JOBS" \
+	'BEGIN { printf "%-12s %10.3f seconds %10.2f jobs/sec\n", "batch (-f)", e - s, n / (e - s) }'
@@ -0,0 +1,35 @@
+#!/bin/sh
+# -------------------------------------------------------------------
+# Compare a sweep with and without -q (classify the Gram points first,
+# and sample only the intervals next to a bad Gram point): the run
+# time, and the totals, which must be the same.
+#
+# Usage: bench/classify.sh [t] [T] [c]
+# -------------------------------------------------------------------
+TURING=${TURING:-./turing}
+T1=${1:-10854395965}
+T2=${2:-10854396965}
+C=${3:-32}
+
+run() {
+	"$TURING" -t "$T1" -T "$T2" -g 24 -c "$C" -s "$@" 2>/dev/null > "$OUT"
+	sed -n 's/^Compute took \([0-9.]*\) seconds.*/\1/p' "$OUT"
+}
+
+OUT=$(mktemp)
+full=$(run)
+grep '^Zeros Found' "$OUT" > "$OUT.full"
+quick=$(run -q)
+grep '^Zeros Found' "$OUT" > "$OUT.quick"
+grep '^Classification' "$OUT"
+
+echo "t = $T1 through $T2, -c $C"
+echo "full sweep: $full seconds"
+echo "with -q:    $quick seconds ($(awk "BEGIN { printf \"%.1f\", $full / $quick }")x)"
+if cmp -s "$OUT.full" "$OUT.quick"; then
+	echo "totals: same"
+else
+	echo "totals: DIFFERENT"
+	cat "$OUT.full" "$OUT.quick"
+fi
+rm -f "$OUT" "$OUT.full" "$OUT.quick"
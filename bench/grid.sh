@@ -0,0 +1,46 @@
+#!/bin/sh
+# -------------------------------------------------------------------
+# Check the -E grid engine against MPFR, and time it.  The same sweep
+# is run with MPFR (no option), with -m and with -E.  Every Hardy Z
+# value -E reports must be within its reported largest error bound of
+# the MPFR value (plus the report's rounding), with the same sign,
+# and the totals must be the same.
+#
+# Usage: bench/grid.sh [t] [G] [c]
+# -------------------------------------------------------------------
+TURING=${TURING:-./turing}
+T1=${1:-1000000000}
+G=${2:-48}
+C=${3:-64}
+
+OUT=$(mktemp)
+
+run() {
+	"$TURING" -t "$T1" -G "$G" -g 24 -c "$C" -s $2 2>/dev/null > "$OUT.$1"
+	grep '^G(' "$OUT.$1" | awk -F', ' '{ print $3 }' > "$OUT.$1.z"
+	grep '^Zeros Found' "$OUT.$1" > "$OUT.$1.sum"
+	sed -n 's/^Compute took \([0-9.]*\) seconds.*/\1/p' "$OUT.$1"
+}
+
+mpfr=$(run mpfr "")
+mixed=$(run mixed -m)
+grid=$(run grid -E)
+bound=$(sed -n 's/^Grid engine: .* = \([0-9.e+-]*\).*/\1/p' "$OUT.grid")
+
+echo "t = $T1, $G Gram intervals, -c $C"
+echo "MPFR: $mpfr seconds"
+echo "-m:   $mixed seconds"
+echo "-E:   $grid seconds ($(awk "BEGIN { printf \"%.1f\", $mixed / $grid }")x -m)"
+paste -d' ' "$OUT.mpfr.z" "$OUT.grid.z" | awk -v b="$bound" '
+	{ d = $1 - $2; d = d < 0 ? -d : d; m = d > m ? d : m; s += ($1 < 0) != ($2 < 0) }
+	END { printf "largest |Z(-E) - Z(MPFR)| = %.3e, bound = %s, signs different = %d\n", m, b, s;
+		exit (m <= b + 1e-10 && s == 0) ? 0 : 1 }'
+status=$?
+if cmp -s "$OUT.mpfr.sum" "$OUT.grid.sum"; then
+	echo "totals: same"
+else
+	echo "totals: DIFFERENT"
+	status=1
+fi
+rm -f "$OUT" "$OUT".*
+exit $status
@@ -0,0 +1,37 @@
+#!/bin/sh
+# -------------------------------------------------------------------
+# Compare the two threading strategies on a 24 Gram interval run:
+# (1) -k N, threading inside each Hardy Z evaluation (libHGT), and
+# (2) -w N, whole Gram intervals handed out to N worker threads.
+#
+# Usage: bench/pool.sh [t] [c] [max threads] [repeats]
+# -------------------------------------------------------------------
+TURING=${TURING:-./turing}
+T=${1:-10854395965}
+C=${2:-32}
+MAX=${3:-8}
+REPEATS=${4:-3}
+
+# Best of REPEATS runs, taken from the -s "Compute took" line.
+best() {
+	r=0
+	best=""
+	while [ $r -lt "$REPEATS" ]; do
+		s=$("$TURING" "$@" -s 2>/dev/null | sed -n 's/^Compute took \([0-9.]*\) seconds.*/\1/p')
+		if [ -z "$best" ] || awk "BEGIN { exit !($s < $best) }"; then
+			best=$s
+		fi
+		r=$((r + 1))
+	done
+	echo "$best"
+}
+
+echo "t = $T, -g 24, -c $C, best of $REPEATS"
+printf "%8s %12s %12s\n" threads "-k seconds" "-w seconds"
+n=1
+while [ $n -le "$MAX" ]; do
+	k=$(best -t "$T" -g 24 -c "$C" -k $n)
+	w=$(best -t "$T" -g 24 -c "$C" -w $n)
+	printf "%8d %12s %12s\n" $n "$k" "$w"
+	n=$((n * 2))
+done
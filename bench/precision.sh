@@ -0,0 +1,44 @@
+#!/bin/sh
+# -------------------------------------------------------------------
+# For one 't' in each decade, compare the run time and the decisions
+# (the sign of each Hardy Z sample, the zero crossings and the Lehmer
+# flags) at several -b values, and at -b auto.  The decisions at
+# 1024 bits are the reference: "stable" means every decision matches.
+#
+# Usage: bench/precision.sh [first decade] [last decade] [g]
+# -------------------------------------------------------------------
+TURING=${TURING:-./turing}
+FIRST=${1:-3}
+LAST=${2:-10}
+G=${3:-8}
+REF=$(mktemp)
+RUN=$(mktemp)
+trap 'rm -f "$REF" "$RUN"' EXIT
+
+# The decisions of one report: the row label, 't', the sign of Hardy Z,
+# and the zero crossing and Lehmer columns.
+decisions() {
+	awk -F, '/^G\(/ { print $1, $2, ($3 < 0), $5, $6 }' "$1"
+}
+
+printf "%14s %6s %10s %8s\n" t bits seconds stable
+d=$FIRST
+while [ $d -le "$LAST" ]; do
+	t="1$(printf "%0${d}d" 0).5"
+	"$TURING" -t "$t" -g "$G" -b 1024 > "$REF" 2>/dev/null
+	for b in 128 192 256 384 512 auto; do
+		"$TURING" -t "$t" -g "$G" -b $b -s > "$RUN" 2>/dev/null
+		s=$(sed -n 's/^Compute took \([0-9.]*\) seconds.*/\1/p' "$RUN")
+		bits=$b
+		if [ $b = auto ]; then
+			bits="$(sed -n 's/^MPFR precision (-b auto): \([0-9]*\) bits.*/\1/p' "$RUN")a"
+		fi
+		if [ "$(decisions "$REF")" = "$(decisions "$RUN")" ]; then
+			stable=yes
+		else
+			stable=NO
+		fi
+		printf "%14s %6s %10s %8s\n" "$t" "$bits" "$s" "$stable"
+	done
+	d=$((d + 1))
+done
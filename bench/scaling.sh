@@ -0,0 +1,39 @@
+#!/bin/sh
+# -------------------------------------------------------------------
+# Thread scaling of a fixed -g 24 -c 32 workload: the run time at 1,
+# 2, 4, ... -w worker threads (pinned with -P), up to the CPU count,
+# with the speedup and efficiency of each against one thread.
+#
+# Usage: bench/scaling.sh [t] [max threads] [repeats]
+# -------------------------------------------------------------------
+TURING=${TURING:-./turing}
+T=${1:-10854395965}
+MAX=${2:-$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 8)}
+REPEATS=${3:-3}
+
+# Best of REPEATS runs, taken from the -s "Compute took" line.
+best() {
+	r=0
+	best=""
+	while [ $r -lt "$REPEATS" ]; do
+		s=$("$TURING" "$@" -s 2>/dev/null | sed -n 's/^Compute took \([0-9.]*\) seconds.*/\1/p')
+		if [ -z "$best" ] || awk "BEGIN { exit !($s < $best) }"; then
+			best=$s
+		fi
+		r=$((r + 1))
+	done
+	echo "$best"
+}
+
+echo "t = $T, -g 24, -c 32, best of $REPEATS"
+printf "%8s %12s %10s %12s\n" threads seconds speedup efficiency
+n=1
+while :; do
+	s=$(best -t "$T" -g 24 -c 32 -w $n -P)
+	[ $n -eq 1 ] && one=$s
+	awk -v n=$n -v s="$s" -v one="$one" \
+		'BEGIN { printf "%8d %12.6f %10.2f %11.1f%%\n", n, s, one / s, 100 * one / (s * n) }'
+	[ $n -ge "$MAX" ] && break
+	n=$((n * 2))
+	[ $n -gt "$MAX" ] && n=$MAX
+done
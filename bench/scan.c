@@ -0,0 +1,181 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+// Times the sample scan of AnalyzeWindow on a large synthetic set of
+// samples, three ways:
+//
+//   loops   the three passes AnalyzeWindow makes over hInfo (an array
+//           of struct HARDYINFO): rise and TowardZero, then ZeroCross,
+//           then Lehmer.
+//   scan    ScanSamples alone, on contiguous samples and bitsets.
+//   window  what AnalyzeWindow would do with ScanSamples: copy hzValue
+//           out of hInfo, ScanSamples, and copy the results back.
+//
+// Every flag and rise of the scan must equal that of the loops.  The
+// samples are a sum of sines (so there are sign changes and changes
+// of slope of every kind), with a little noise.
+//
+// Usage: scanbench [samples] [repeats]     (make scanbench)
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include <mpfr.h>
+
+#include "hgt.h"
+#include "turing.h"
+#include "turscan.h"
+
+static double Seconds(void)
+{
+struct timespec	ts;
+
+clock_gettime(CLOCK_MONOTONIC, &ts);
+return(ts.tv_sec + (ts.tv_nsec / 1e9));
+}
+
+
+// *******************************************************************
+// The three loops, as AnalyzeWindow has them (for the first window,
+// with the Gram intervals' ZeroCross loop flattened to one loop).
+// *******************************************************************
+static void Loops(struct HARDYINFO *hInfo, int64_t hzNum)
+{
+int64_t		i;
+
+hInfo[0].hzRise = 0;
+for (i = 1; i <= hzNum; i++) {
+	hInfo[i].hzRise     = hInfo[i].hzValue - hInfo[i-1].hzValue;
+	hInfo[i].TowardZero = hInfo[i].hzRise * hInfo[i].hzValue
+		> 0 ? false : true;
+	}
+hInfo[0].ZeroCross = hInfo[1].ZeroCross = false;
+for (i = 2; i <= hzNum; i++) {
+	if(hInfo[i].hzValue * hInfo[i-1].hzValue < 0) {
+		hInfo[i].ZeroCross = true;
+		}
+	else {
+		hInfo[i].ZeroCross = false;
+		}
+	}
+hInfo[0].Lehmer = false;
+for (i = 1; i <= hzNum; i++) {
+	hInfo[i].Lehmer =
+		(hInfo[i].TowardZero == false
+		&& hInfo[i].ZeroCross == false
+		&& hInfo[i-1].TowardZero == true);
+	}
+}
+
+
+// *******************************************************************
+// The scan, with the given flags of the first window.
+// *******************************************************************
+static void Scan(const double *Z, int64_t hzNum, double *Rise, uint64_t *Bits,
+	int64_t Words)
+{
+Bits[0] = Bits[Words] = Bits[2 * Words] = 0;
+ScanSamples(Z, hzNum + 1, Rise, Bits, Bits + Words, Bits + (2 * Words));
+}
+
+
+int main(int argc, char *argv[])
+{
+struct HARDYINFO *	hInfo;
+double *			Z;
+double *			Rise;
+uint64_t *			Bits;
+int64_t				hzNum, Words, i, Bad, Flags[3];
+int					r, Repeats;
+double				x, Begin, tLoops, tScan, tWindow;
+
+hzNum = argc > 1 ? atoll(argv[1]) : 16 * 1024 * 1024;
+Repeats = argc > 2 ? atoi(argv[2]) : 10;
+if(hzNum < 2 || Repeats < 1) {
+	fprintf(stderr, "Usage: scanbench [samples] [repeats] \n");
+	return(EXIT_FAILURE);
+	}
+Words = TURSCAN_WORDS(hzNum + 1);
+if((hInfo = calloc(hzNum + 1, sizeof(struct HARDYINFO))) == NULL
+	|| (Z = malloc((hzNum + 1) * sizeof(double))) == NULL
+	|| (Rise = malloc((hzNum + 1) * sizeof(double))) == NULL
+	|| (Bits = calloc(3 * Words, sizeof(uint64_t))) == NULL) {
+	fprintf(stderr, "Unable to allocate %lld samples \n", (long long) hzNum);
+	return(EXIT_FAILURE);
+	}
+
+srand(12345);
+for(i = 0; i <= hzNum; i++) {
+	x = i * 0.05;
+	Z[i] = hInfo[i].hzValue = (3 * sin(x)) + sin(2.7 * x) + (0.8 * sin(7.1 * x))
+		+ ((rand() / (double) RAND_MAX) - 0.5) * 0.1;
+	}
+
+// -------------------------------------------------------------------
+// Check first, then time.
+// -------------------------------------------------------------------
+Loops(hInfo, hzNum);
+Scan(Z, hzNum, Rise, Bits, Words);
+Bad = Flags[0] = Flags[1] = Flags[2] = 0;
+for(i = 1; i <= hzNum; i++) {
+	Bad += hInfo[i].hzRise != Rise[i]
+		|| hInfo[i].TowardZero != TURSCAN_TEST(Bits, i)
+		|| hInfo[i].ZeroCross != TURSCAN_TEST(Bits + Words, i)
+		|| hInfo[i].Lehmer != TURSCAN_TEST(Bits + (2 * Words), i);
+	Flags[0] += hInfo[i].TowardZero;
+	Flags[1] += hInfo[i].ZeroCross;
+	Flags[2] += hInfo[i].Lehmer;
+	}
+if(ScanCount(Bits + Words, 0, hzNum) != Flags[1]) {
+	Bad++;
+	}
+
+Begin = Seconds();
+for(r = 0; r < Repeats; r++) {
+	Loops(hInfo, hzNum);
+	}
+tLoops = (Seconds() - Begin) / Repeats;
+
+Begin = Seconds();
+for(r = 0; r < Repeats; r++) {
+	Scan(Z, hzNum, Rise, Bits, Words);
+	}
+tScan = (Seconds() - Begin) / Repeats;
+
+Begin = Seconds();
+for(r = 0; r < Repeats; r++) {
+	for(i = 0; i <= hzNum; i++) {
+		Z[i] = hInfo[i].hzValue;
+		}
+	Scan(Z, hzNum, Rise, Bits, Words);
+	for(i = 1; i <= hzNum; i++) {
+		hInfo[i].hzRise     = Rise[i];
+		hInfo[i].TowardZero = TURSCAN_TEST(Bits, i);
+		hInfo[i].ZeroCross  = TURSCAN_TEST(Bits + Words, i);
+		hInfo[i].Lehmer     = TURSCAN_TEST(Bits + (2 * Words), i);
+		}
+	}
+tWindow = (Seconds() - Begin) / Repeats;
+
+printf("%lld samples, %d repeats: %lld toward zero, %lld zero crossings, %lld possible Lehmer \n",
+	(long long) hzNum + 1, Repeats, (long long) Flags[0], (long long) Flags[1], (long long) Flags[2]);
+printf("loops  %9.3f ms  %6.2f ns/sample \n", tLoops * 1e3, tLoops * 1e9 / hzNum);
+printf("scan   %9.3f ms  %6.2f ns/sample  (%.2fx) \n", tScan * 1e3, tScan * 1e9 / hzNum, tLoops / tScan);
+printf("window %9.3f ms  %6.2f ns/sample  (%.2fx) \n", tWindow * 1e3, tWindow * 1e9 / hzNum, tLoops / tWindow);
+if(Bad != 0) {
+	printf("MISMATCH: %lld samples differ \n", (long long) Bad);
+	return(EXIT_FAILURE);
+	}
+printf("Identical results \n");
+return(EXIT_SUCCESS);
+}
@@ -0,0 +1,42 @@
+#!/bin/sh
+# -------------------------------------------------------------------
+# Shard-and-merge on one machine: plan a sweep from t to T as shards
+# (turing -S), run each shard as its own process, stitch the shards
+# with turmerge, and check that the merged totals are the totals of
+# the same sweep run as one process.
+#
+# Usage: bench/shards.sh [t] [T] [shards] [c]
+# -------------------------------------------------------------------
+TURING=${TURING:-./turing}
+TURMERGE=${TURMERGE:-./turmerge}
+T1=${1:-10854395965}
+T2=${2:-10854396065}
+SHARDS=${3:-4}
+C=${4:-8}
+DIR=$(mktemp -d)
+
+"$TURING" -t "$T1" -T "$T2" -c "$C" -g 24 -S "$SHARDS" -B "$DIR/shard" 2>/dev/null > "$DIR/plan"
+cat "$DIR/plan"
+
+start=$(date +%s.%N)
+grep '^turing ' "$DIR/plan" > "$DIR/jobs"
+while read -r _ args; do
+	# shellcheck disable=SC2086
+	"$TURING" $args > /dev/null 2>&1 &
+done < "$DIR/jobs"
+wait
+end=$(date +%s.%N)
+
+"$TURMERGE" "$DIR"/shard-*.bin > "$DIR/report"
+merged=$?
+tail -1 "$DIR/report" > "$DIR/merged"
+"$TURING" -t "$T1" -T "$T2" -c "$C" -g 24 2>/dev/null | grep '^Zeros Found' > "$DIR/single"
+echo "shards took $(awk "BEGIN { print $end - $start }") seconds"
+echo "merged: $(cat "$DIR/merged")"
+echo "single: $(cat "$DIR/single")"
+if [ $merged -eq 0 ] && [ "$(tr -s ' ' < "$DIR/merged")" = "$(tr -s ' ' < "$DIR/single")" ]; then
+	echo "same"
+else
+	echo "DIFFERENT"
+fi
+rm -rf "$DIR"
@@ -0,0 +1,115 @@
+#!/bin/sh
+# -------------------------------------------------------------------
+# The benchmark suite.  Runs a fixed matrix over the known hard
+# regions (the Lehmer pair near 7005.06, the cases near 10854395965
+# and 35615956517, and the Lehmer triplet near 12125272), at each -b
+# in BITS, -c in COUNTS and -k in THREADS, each REPEATS times, and
+# prints one line of JSON per case: the median and interquartile
+# range of the compute time, the Hardy Z evaluations per second, and
+# whether the zeros found in each Gram interval and the samples
+# flagged as possible Lehmer points match bench/expected.txt.  No
+# expected results are shipped: record them (below) with the release
+# libHGT, and until then each case's check is "no_expected".
+#
+# A mismatch fails the suite, unless the case's -b is below the bits
+# -b auto chooses for its 't' (then the check is "low_bits": fewer
+# bits than that are not expected to be safe).
+#
+# bench/suite.sh -record rewrites bench/expected.txt from this build,
+# at the -b auto bits.  Do that only with a build you trust.
+#
+# Usage: bench/suite.sh [repeats]      (or: make bench)
+#        bench/suite.sh -record
+# -------------------------------------------------------------------
+TURING=${TURING:-./turing}
+BITS=${BITS:-"128 256 512 1024"}
+COUNTS=${COUNTS:-"8 32 128"}
+THREADS=${THREADS:-"1 2 4 8"}
+REPEATS=${1:-5}
+G=4
+EXPECTED=$(dirname "$0")/expected.txt
+CASES=${CASES:-"7005 12125271.5 10854395965 35615956517"}
+
+RUN=$(mktemp)
+TIMES=$(mktemp)
+trap 'rm -f "$RUN" "$TIMES"' EXIT
+
+# The zeros found in each Gram interval, and the samples ("i.j" for
+# sample j of Gram interval i) flagged as possible Lehmer points.
+fingerprint() {
+	zeros=$(sed -n 's/^Gram idx = [0-9]*, Zeros Found = \([0-9]*\),.*/\1/p' "$1" | paste -sd, -)
+	lehmer=$(awk -F, '/^G\(/ && $6 ~ /Lehmer/ {
+		sub(/^G\( */, "", $1); split($1, a, /\) +/); print a[1] "." a[2] }' "$1" | paste -sd, -)
+	echo "${zeros:--} ${lehmer:--}"
+}
+
+autobits() {
+	"$TURING" -t "$1" -G 1 -S 1 -b auto 2>/dev/null \
+		| sed -n 's/^MPFR precision (-b auto): \([0-9]*\) bits.*/\1/p'
+}
+
+if [ "$1" = "-record" ]; then
+	{
+		echo "# Expected results for bench/suite.sh (-g $G, recorded at the -b auto bits)."
+		echo "# t  c  zeros-per-Gram-interval  Lehmer-samples"
+		for t in $CASES; do
+			for c in $COUNTS; do
+				"$TURING" -t "$t" -g $G -c "$c" -b auto -v > "$RUN" 2>/dev/null
+				echo "$t $c $(fingerprint "$RUN")"
+				echo "recorded t = $t, -c $c" >&2
+			done
+		done
+	} > "$EXPECTED.new" && mv "$EXPECTED.new" "$EXPECTED"
+	exit 0
+fi
+
+failed=0
+for t in $CASES; do
+	auto=$(autobits "$t")
+	for c in $COUNTS; do
+		expect=
+		if [ -f "$EXPECTED" ]; then
+			expect=$(awk -v t="$t" -v c="$c" '$1 == t && $2 == c { print $3, $4 }' "$EXPECTED")
+		fi
+		for b in $BITS; do
+			for k in $THREADS; do
+				: > "$TIMES"
+				check=ok
+				r=0
+				while [ $r -lt "$REPEATS" ]; do
+					"$TURING" -t "$t" -g $G -c "$c" -b "$b" -k "$k" -v -s > "$RUN" 2>/dev/null
+					sed -n 's/^Compute took \([0-9.]*\) seconds.*/\1/p' "$RUN" >> "$TIMES"
+					if [ $r -eq 0 ]; then
+						evals=$(sed -n 's/^Hardy Z evaluations = \([0-9]*\) .*/\1/p' "$RUN")
+						got=$(fingerprint "$RUN")
+						if [ -z "$expect" ]; then
+							check=no_expected
+						elif [ "$got" != "$expect" ]; then
+							if [ "$b" -lt "$auto" ]; then
+								check=low_bits
+							else
+								check=MISMATCH
+								failed=1
+							fi
+						fi
+					fi
+					r=$((r + 1))
+				done
+				sort -n "$TIMES" | awk -v t="$t" -v g=$G -v c="$c" -v b="$b" -v k="$k" \
+					-v evals="${evals:-0}" -v check="$check" '
+					{ x[NR] = $1 }
+					function q(p,   i, f) {
+						i = 1 + (NR - 1) * p; f = int(i)
+						return (f >= NR) ? x[NR] : x[f] + (i - f) * (x[f + 1] - x[f])
+					}
+					END {
+						m = q(0.5)
+						printf "{\"t\":\"%s\",\"g\":%d,\"c\":%d,\"bits\":%d,\"k\":%d,\"repeats\":%d,", t, g, c, b, k, NR
+						printf "\"median\":%.6f,\"iqr\":%.6f,\"evals\":%d,\"evals_per_sec\":%.1f,\"check\":\"%s\"}\n",
+							m, q(0.75) - q(0.25), evals, (m > 0 ? evals / m : 0), check
+					}'
+			done
+		done
+	done
+done
+exit $failed
@@ -1,3 +1,24 @@
 gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c turing.c 
 gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c CompTuring.c 
-gcc -static -pthread -o turing turing.o CompTuring.o  -L. -l:libhgt.a -l:libmpfr.a -l:libgmp.a
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c PoolTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c RefineTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c GramTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c CkptTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c BinTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c MixedTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c RosserTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c BatchTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c StatsTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c CpuTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c ShardTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c ClassTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c ZeroTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c GridTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c CacheTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c IndexTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c DaemonTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c PlanTuring.c 
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -pthread -c WriterTuring.c 
+gcc -static -pthread -o turing turing.o CompTuring.o PoolTuring.o RefineTuring.o GramTuring.o CkptTuring.o BinTuring.o MixedTuring.o RosserTuring.o BatchTuring.o StatsTuring.o CpuTuring.o ShardTuring.o ClassTuring.o ZeroTuring.o GridTuring.o CacheTuring.o IndexTuring.o DaemonTuring.o PlanTuring.o WriterTuring.o  -L. -l:libhgt.a -l:libmpfr.a -l:libgmp.a
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -o turdump turdump.c
+gcc -Wall -Wextra -pedantic-errors -std=gnu17 -o turmerge turmerge.c
@@ -0,0 +1,55 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+// The layout of the binary Hardy Z sample file written with -B, and
+// read by turdump.  The file is a TURBINHEADER followed by CountRecords
+// TURBINRECORDs.  Everything is naturally aligned and little-endian
+// (as written by the host), so a reader can mmap the file and use the
+// records in place.
+//
+// Record k holds sample k of the sweep: record 0 is the sample just
+// before the first Gram point, record 1 + (i * CountZ) + j is sample j
+// of Gram interval i, and the last record is the Gram point after the
+// last interval.  So the records are exactly the rows of the text
+// report, without the rows repeated between sweep windows.
+// -------------------------------------------------------------------
+
+#define	TURBIN_MAGIC		"TURZBIN1"
+#define	TURBIN_VERSION		2
+
+#define	TURBIN_ZEROCROSS	0x01	// zero crossed since the previous sample
+#define	TURBIN_TOWARDZERO	0x02	// Hardy Z is moving toward zero
+#define	TURBIN_LEHMER		0x04	// possible Lehmer problem
+#define	TURBIN_GRAMGOOD		0x08	// (Sub 0 only) the Gram point is good
+#define	TURBIN_BEFORE		0x10	// the sample before the first Gram point
+
+struct TURBINHEADER {
+	char		Magic[8];		// TURBIN_MAGIC (not NUL terminated)
+	uint32_t	Version;		// TURBIN_VERSION
+	uint32_t	HeaderSize;		// sizeof(struct TURBINHEADER)
+	uint32_t	RecordSize;		// sizeof(struct TURBINRECORD)
+	uint32_t	Bits;			// MPFR bits used ('-b')
+	uint32_t	CountZ;			// samples per Gram interval ('-c')
+	uint32_t	Reserved;
+	uint64_t	StartN;			// 'n' of the first Gram point
+	uint64_t	CountGram;		// number of Gram intervals in the file
+	uint64_t	CountRecords;	// (CountGram * CountZ) + 2
+	double		BaseT;			// g(StartN), as a double
+	char		sBaseT[320];	// g(StartN), exactly, in hex ("%Ra", NUL terminated)
+};
+
+struct TURBINRECORD {
+	uint64_t	n;				// 'n' of the Gram point starting the interval
+	uint32_t	Sub;			// sample within the interval (0 = Gram point)
+	uint32_t	Flags;			// TURBIN_xxx bits
+	double		tOffset;		// t - g(StartN)
+	double		hzValue;		// Hardy Z(t)
+	double		hzRise;			// hzValue less the previous sample's hzValue
+};
+
+_Static_assert(sizeof(struct TURBINHEADER) == 384, "TURBINHEADER must be 384 bytes");
+_Static_assert(sizeof(struct TURBINRECORD) == 40, "TURBINRECORD must be 40 bytes");
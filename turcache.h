@@ -0,0 +1,61 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+// The layout of the cache file used with -H.  The file is a
+// TURCACHEHEADER followed by records, each a TURCACHERECORD and then
+// Size bytes of data.  Records are only ever appended.  Everything is
+// naturally aligned and little-endian (as written by the host), so
+// the file can be mapped and the records used in place.
+//
+// A TURCACHE_GRAM record holds g(n), located with Bits bits, as the
+// text of "%Ra" (so it is exact), NUL padded to a multiple of 8 bytes.
+// A TURCACHE_SAMPLES record holds the CountZ Hardy Z values (doubles)
+// of the Gram interval that begins at g(n), computed with Bits bits
+// in the given Mode.  A TURCACHE_POINT record holds Hardy Z at g(n)
+// alone (as computed for the Gram point after a window), and a
+// TURCACHE_BEFORE record Hardy Z one sub-interval (of CountZ) before
+// g(n) (as computed for the first window of a run).
+//
+// Check is a checksum of the record, so a record cut short by a crash
+// (the only way a record can be damaged) is found, and the file is
+// cut back to the records before it.
+// -------------------------------------------------------------------
+
+#define	TURCACHE_MAGIC		"TURCACH1"
+#define	TURCACHE_VERSION	1
+
+#define	TURCACHE_GRAM		1
+#define	TURCACHE_SAMPLES	2
+#define	TURCACHE_POINT		3
+#define	TURCACHE_BEFORE		4
+
+#define	TURCACHE_MPFR		0		// Mode: Hardy Z with MPFR
+#define	TURCACHE_MIXED		1		// ... with -m
+#define	TURCACHE_GRID		2		// ... with -E
+
+#define	TURCACHE_DATA_MAX	4096	// bytes of data in a record
+
+struct TURCACHEHEADER {
+	char		Magic[8];		// TURCACHE_MAGIC (not NUL terminated)
+	uint32_t	Version;		// TURCACHE_VERSION
+	uint32_t	HeaderSize;		// sizeof(struct TURCACHEHEADER)
+	uint32_t	RecordSize;		// sizeof(struct TURCACHERECORD)
+	uint32_t	Reserved[3];
+};
+
+struct TURCACHERECORD {
+	uint64_t	n;				// 'n' of the Gram point
+	uint32_t	Kind;			// TURCACHE_GRAM or TURCACHE_SAMPLES
+	uint32_t	Bits;			// MPFR bits used ('-b')
+	uint32_t	CountZ;			// (samples) samples per Gram interval ('-c'), else 0
+	uint32_t	Mode;			// (samples) TURCACHE_MPFR, _MIXED or _GRID, else 0
+	uint32_t	Size;			// bytes of data after this record (a multiple of 8)
+	uint32_t	Check;			// see CacheCheck
+};
+
+_Static_assert(sizeof(struct TURCACHEHEADER) == 32, "TURCACHEHEADER must be 32 bytes");
+_Static_assert(sizeof(struct TURCACHERECORD) == 32, "TURCACHERECORD must be 32 bytes");
@@ -0,0 +1,145 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+// turdump: a small reader for the binary Hardy Z sample files written
+// by "turing -B".  It maps the file (see turbin.h), checks the header,
+// and prints the header and the requested records as text.  It does
+// not need libHGT or MPFR.
+//
+// Usage: turdump [file] [first record] [record count]
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "turbin.h"
+
+static const char *	MapFile(const char *sFile, size_t *pSize);
+
+
+int main( int argc, char *argv[] )
+{
+const char *				pFile;
+const struct TURBINHEADER *	pHeader;
+const struct TURBINRECORD *	pRec;
+size_t						Size;
+uint64_t					First = 0, Count, k;
+
+if(argc < 2 || argc > 4) {
+	printf("Usage: turdump [file] [first record] [record count]\n");
+	return(EXIT_FAILURE);
+	}
+if((pFile = MapFile(argv[1], &Size)) == NULL) {
+	printf("Unable to read %s \n", argv[1]);
+	return(EXIT_FAILURE);
+	}
+
+// -------------------------------------------------------------------
+// Check the header before trusting any of the records.
+// -------------------------------------------------------------------
+pHeader = (const struct TURBINHEADER *) pFile;
+if(Size < sizeof(struct TURBINHEADER)
+	|| memcmp(pHeader->Magic, TURBIN_MAGIC, sizeof(pHeader->Magic)) != 0
+	|| pHeader->Version != TURBIN_VERSION
+	|| pHeader->HeaderSize != sizeof(struct TURBINHEADER)
+	|| pHeader->RecordSize != sizeof(struct TURBINRECORD)) {
+	printf("The file %s is not a version %d binary sample file \n", argv[1], TURBIN_VERSION);
+	return(EXIT_FAILURE);
+	}
+Count = (Size - sizeof(struct TURBINHEADER)) / sizeof(struct TURBINRECORD);
+if(Count < pHeader->CountRecords) {
+	printf("Note: the file holds %ju of %ju records (incomplete run?)\n",
+		(uintmax_t) Count, (uintmax_t) pHeader->CountRecords);
+	}
+else {
+	Count = pHeader->CountRecords;
+	}
+
+printf("Start n = %ju, g(n) = %.17g (exactly %s), bits = %u, samples per Gram interval = %u\n",
+	(uintmax_t) pHeader->StartN, pHeader->BaseT, pHeader->sBaseT, pHeader->Bits, pHeader->CountZ);
+printf("Gram intervals = %ju, records = %ju\n\n", (uintmax_t) pHeader->CountGram,
+	(uintmax_t) pHeader->CountRecords);
+
+if(argc >= 3) {
+	First = strtoull(argv[2], NULL, 10);
+	}
+if(argc == 4 && First + strtoull(argv[3], NULL, 10) < Count) {
+	Count = First + strtoull(argv[3], NULL, 10);
+	}
+
+// -------------------------------------------------------------------
+// The records are used in place -- no copying.
+// -------------------------------------------------------------------
+pRec = (const struct TURBINRECORD *) (pFile + sizeof(struct TURBINHEADER));
+for(k = First; k < Count; k++) {
+	printf("%10ju n = %ju, %3u, t = g + %.10f, %15.10f, %10.6f, %9s, %7s%s%s\n",
+		(uintmax_t) k, (uintmax_t) pRec[k].n, pRec[k].Sub, pRec[k].tOffset,
+		pRec[k].hzValue, pRec[k].hzRise,
+		pRec[k].Flags & TURBIN_ZEROCROSS ? "Crossing" : " ",
+		pRec[k].Flags & TURBIN_LEHMER ? "Lehmer" : " ",
+		pRec[k].Flags & TURBIN_GRAMGOOD ? ", Gram good" : "",
+		pRec[k].Flags & TURBIN_BEFORE ? ", before first Gram point" : "");
+	}
+return(EXIT_SUCCESS);
+}
+
+
+// *******************************************************************
+// We map the whole file read-only.  (On Windows, we just read it.)
+// *******************************************************************
+static const char * MapFile(const char *sFile, size_t *pSize)
+{
+#ifdef _WIN32
+FILE	*fp;
+char	*pData;
+long	Size;
+
+if((fp = fopen(sFile, "rb")) == NULL) {
+	return(NULL);
+	}
+fseek(fp, 0, SEEK_END);
+Size = ftell(fp);
+fseek(fp, 0, SEEK_SET);
+if(Size <= 0 || (pData = malloc((size_t) Size)) == NULL
+	|| fread(pData, (size_t) Size, 1, fp) != 1) {
+	fclose(fp);
+	return(NULL);
+	}
+fclose(fp);
+*pSize = (size_t) Size;
+return(pData);
+#else
+struct stat	st;
+void		*pData;
+int			fd;
+
+if((fd = open(sFile, O_RDONLY)) < 0) {
+	return(NULL);
+	}
+if(fstat(fd, &st) != 0 || st.st_size <= 0) {
+	close(fd);
+	return(NULL);
+	}
+pData = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+close(fd);
+if(pData == MAP_FAILED) {
+	return(NULL);
+	}
+*pSize = (size_t) st.st_size;
+return((const char *) pData);
+#endif
+}
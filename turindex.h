@@ -0,0 +1,48 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+// The layout of the Gram point index built with -X and read with -I.
+// The file is a TURIDXHEADER followed by Count TURIDXRECORDs, record
+// k holding g(FirstN + (k * Stride)).  Everything is naturally aligned
+// and little-endian (as written by the host), so the file can be
+// mapped and the records used in place.
+//
+// sGram is g(n) in decimal, to TUR_GRAM_DIGITS + TURIDX_EXTRA_DIGITS
+// digits after the '.', so it is well inside the Accuracy the Gram
+// points are located to.  dGram is the same as a double, for the
+// binary search of IndexNearT.  Bits and Digits record how the index
+// was built: an index built with other bits, or another Accuracy, is
+// not used.
+// -------------------------------------------------------------------
+
+#define	TURIDX_MAGIC		"TURGIDX1"
+#define	TURIDX_VERSION		1
+#define	TURIDX_EXTRA_DIGITS	8
+#define	TURIDX_TEXT_MAX		112
+
+struct TURIDXHEADER {
+	char		Magic[8];		// TURIDX_MAGIC (not NUL terminated)
+	uint32_t	Version;		// TURIDX_VERSION
+	uint32_t	HeaderSize;		// sizeof(struct TURIDXHEADER)
+	uint32_t	RecordSize;		// sizeof(struct TURIDXRECORD)
+	uint32_t	Bits;			// MPFR bits used ('-b')
+	uint32_t	Digits;			// Gram points located to 0.5e-Digits (TUR_GRAM_DIGITS)
+	uint32_t	Reserved;
+	uint64_t	FirstN;			// 'n' of record 0
+	uint64_t	Stride;			// 'n' from one record to the next ('-X')
+	uint64_t	Count;			// number of records
+	uint64_t	Reserved2;
+};
+
+struct TURIDXRECORD {
+	uint64_t	n;				// 'n' of the Gram point
+	double		dGram;			// g(n), as a double
+	char		sGram[TURIDX_TEXT_MAX];	// g(n), in decimal (NUL terminated)
+};
+
+_Static_assert(sizeof(struct TURIDXHEADER) == 64, "TURIDXHEADER must be 64 bytes");
+_Static_assert(sizeof(struct TURIDXRECORD) == 128, "TURIDXRECORD must be 128 bytes");
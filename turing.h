@@ -6,9 +6,59 @@
 
 #define	TUR_HARDY_WIDTH		15
 #define	TUR_HARDY_DECIMALS	10
+#define	TUR_WORKERS_MAX		256
+#define	TUR_THREADS_MAX		8		// libHGT's limit on -k (see ValidateThreads)
+#define	TUR_CPU_MAX			1024	// CPUs that -P will pin worker threads to
+#define	TUR_NODES_MAX		64		// NUMA nodes that -P looks for
+#define	TUR_REFINE_POINTS	8
+#define	TUR_REFINE_MAX		16
+#define	TUR_ZERO_DIGITS_MAX	60		// -Z: most digits a zero is located to
+#define	TUR_ZERO_STEPS		100		// -Z: most Illinois steps per zero
+#define	TUR_GRAM_NEXT_MIN	100		// below this, GramNext just calls GramAtN
+#define	TUR_GRAM_NEXT_STEPS	8		// most Newton steps taken by GramNext
+#define	TUR_GRAM_DIGITS		16		// Gram points are located to 0.5e-16 (see GramAccuracy)
+#define	TUR_GRAM_NEAR_MARGIN	1e-12	// see IndexNearT
+#define	TUR_INDEX_STRIDE_MAX	100000	// -X: most Gram points between index entries
+#define	TUR_PATH_MAX		512
+#define	TUR_T_TEXT_MAX		(HGT_MAX_CMDLINE_STRLEN + 64)	// a 't' as the report shows it
+#define	TUR_STDOUT_BUF		(1 << 20)	// stdout buffer (flushed after each report)
+#define	TUR_STATS_BUCKETS	160		// latency histogram: 4 buckets per power of 2 ns
+#define	TUR_BATCH_LINE_MAX	512		// also a -D request
+#define	TUR_DAEMON_QUEUE_MAX	64		// -D: most requests waiting for a worker
+#define	TUR_DAEMON_TIMEOUT	30		// -D: seconds a client may take to send, or to read
+#define	TUR_WRITER_SLOTS	8		// -O: text blocks and windows waiting for the writer thread
+#define	TUR_WRITER_SNAPS	2		// -O: copies of a window's data the writer may hold at once
+#define	TUR_SHARDS_MAX		100000	// most shards -S will plan
+#define	TUR_ROSSER_GRAM_MAX	1000000	// -R without -T or -G: at most this many intervals
+#define	TUR_MIXED_MIN		200		// below this, -m always uses MPFR
+#define	TUR_MIXED_C0_MIN	1e-6	// |cos(2 pi p)| below this, -m uses MPFR
+#define	TUR_GRID_TERMS_MAX	(1L << 20)	// -E: most Riemann-Siegel terms (t to about 6.6e12)
+#define	TUR_CTX_MAX			1024	// Turing computations that may run at once
+#define	TUR_CTX_SHIFT		16		// see TUR_CALLER
+#define	TUR_CTX_MASK		0xFFFF
+#define	TUR_CKPT_MAGIC		"TURING-CHECKPOINT 2"
+#define	TUR_CKPT_LINE_MAX	1024
+
+// -------------------------------------------------------------------
+// The phases timed for -s and -J (see StatsTuring.c).
+// -------------------------------------------------------------------
+#define	TUR_PHASE_SETUP		0		// InitMPFR, InitCoeffMPFR, gList (and the reverse)
+#define	TUR_PHASE_GRAMNEAR	1		// GramNearT
+#define	TUR_PHASE_GRAMPTS	2		// GramWindow (GramAtN and GramNext)
+#define	TUR_PHASE_HARDYZ	3		// HardyZWindow
+#define	TUR_PHASE_REFINE	4		// RefineWindow (-a)
+#define	TUR_PHASE_ANALYSIS	5		// AnalyzeWindow and SweepTally
+#define	TUR_PHASE_REPORT	6		// TuringReport
+#define	TUR_PHASE_OUTPUT	7		// checkpoint and binary sample file
+#define	TUR_PHASE_ZEROS		8		// ZeroWindow (-Z)
+#define	TUR_PHASE_COUNT		9
 
 struct TURING {
 	char	tBuf[HGT_MAX_CMDLINE_STRLEN + 2];	// holds entered '-t' value
+	char	TBuf[HGT_MAX_CMDLINE_STRLEN + 2];	// holds entered '-T' value (sweep end)
+	uint64_t	SweepGram;			// number of Gram intervals to sweep (0 = no sweep)
+	uint64_t	StartN;				// start at this Gram point ('-n'), or 0 to use 't'
+	int		Shards;					// -S: print a plan of this many shards (0 = none)
 	int 	CountZ;    	 			// number of Z(t) in Gram interval
 	int 	CountGram;   			// number of Gram interval	
 	bool	Verbose;				// T/F: verbose report
@@ -17,6 +67,27 @@ struct TURING {
 	int		OutputDP;				// digits after '.' in report
 	int		DefaultBits;			// Bits for MPFR floating point 
 	int		Threads;				// Number of threads to use 
+	int		Workers;				// Number of Gram interval worker threads
+	bool	Pin;					// T/F: pin each worker thread to its own CPUs ('-P')
+	int		Refine;					// Adaptive refinement levels (0 = none)
+	int		WindowMax;				// Gram intervals per sweep window (the '-g' value)
+	char	CkptFile[TUR_PATH_MAX];	// checkpoint file ('-C'), or empty
+	bool	Resume;					// T/F: resume from the checkpoint file
+	char	BinFile[TUR_PATH_MAX];	// binary sample file ('-B'), or empty
+	char	CacheFile[TUR_PATH_MAX];	// Gram point and Hardy Z cache file ('-H'), or empty
+	char	IndexFile[TUR_PATH_MAX];	// Gram point index file ('-I'), or empty
+	uint64_t	IndexStride;		// -X: build the -I index, an entry every IndexStride Gram points (0 = no)
+	char	BatchFile[TUR_PATH_MAX];	// batch file ('-f'), "-" for stdin, or empty
+	char	DaemonSocket[TUR_PATH_MAX];	// -D: serve requests on this Unix-domain socket, or empty
+	bool	Rosser;					// T/F: stop after K Gram blocks satisfy Rosser's rule
+	bool	AutoBits;				// T/F: -b auto (see AutoPrecision)
+	bool	Json;					// T/F: print the -s statistics as JSON ('-J')
+	bool	Mixed;					// T/F: double precision first, MPFR only if needed
+	bool	Grid;					// T/F: ('-E') -m, each Gram interval's samples at once
+	int		ZeroDigits;				// locate each zero to within 10^-ZeroDigits ('-Z', 0 = no)
+	bool	Classify;				// T/F: ('-q') sample only the Gram intervals not settled by Gram's law
+	bool	Plan;					// T/F: ('-M') calibrate, and predict the run time and settings
+	bool	Writer;					// T/F: ('-O') write the report from a writer thread
 }; 
 
 struct GRAMLIST {
@@ -27,7 +98,9 @@ struct GRAMLIST {
 	int			MinusOneToN;	// 1 if n even, -1 if n odd
 	bool		Good;			// T/F: (-1)^n * HardyZ[0] > 0
 	bool		OddZeros;		// T/F: this and next Gram point are both good or both bad
+	bool		Settled;		// T/F: (-q) this and next Gram point are both good, so not sampled
 	int			ZerosFound;		// Number of zero crossings between intervals
+	double		GridBound;		// (-E) largest error bound of the interval's samples
 }; 
 
 struct HARDYINFO {
@@ -36,12 +109,188 @@ struct HARDYINFO {
 	bool		ZeroCross;		// T/F: zero crossed between previous and current Hardy points
 	bool		TowardZero;		// T/F: Value is moving toward zero (no slope is towards)
 	bool		Lehmer;			// T/F: possible Lehmer condition 
+	int			RefineZeros;	// zero crossings found by refinement before this point
 }; 
 
+struct SWEEP {
+	uint64_t	Total;			// number of Gram intervals in the sweep
+	uint64_t	Done;			// number of Gram intervals already reported
+	uint64_t	Window;			// current window (counting from 0)
+	uint64_t	ZerosFound;		// zero crossings found in all windows
+	uint64_t	BadGram;		// bad Gram points in all windows
+	uint64_t	BadParity;		// intervals with an unexpected even/odd zero count
+	uint64_t	Lehmer;			// samples flagged as a possible Lehmer problem
+	uint64_t	RefineSegments;	// sub-intervals re-sampled by adaptive refinement
+	uint64_t	RefineZeros;	// zero crossings found by adaptive refinement
+	uint64_t	RefineEvals;	// Hardy Z values computed by adaptive refinement
+	int			RosserK;		// consecutive Gram blocks needed (ComputeTuringK)
+	int			RosserRun;		// consecutive Gram blocks so far that satisfy Rosser's rule
+	uint64_t	RosserBlocks;	// Gram blocks checked
+	uint64_t	RosserFailed;	// ... of which failed Rosser's rule
+	uint64_t	RosserEndN;		// 'n' of the Gram point that ended the last block needed
+	bool		RosserDone;		// T/F: K consecutive Gram blocks found
+	bool		BlockOpen;		// T/F: a Gram block is open (a good Gram point was seen)
+	int			BlockLen;		// Gram intervals in the open Gram block
+	int			BlockZeros;		// zeros found in the open Gram block
+	uint64_t	MixedSamples;	// Hardy Z values computed with -m
+	uint64_t	MixedEscalated;	// ... of which were re-computed with MPFR
+	double		GridBound;		// (-E) largest error bound of any double precision value
+	uint64_t	ClassSettled;	// (-q) Gram intervals settled by Gram's law
+	uint64_t	ClassGram;		// (-q) Gram point signs found
+	uint64_t	ClassEscalated;	// ... of which needed MPFR
+	uint64_t	ClassSamples;	// (-q) other Hardy Z values computed
+	uint64_t	ZeroLocated;	// (-Z) zeros located
+	uint64_t	ZeroEvals;		// ... and the Hardy Z values that took
+	uint64_t	CacheGramHits;	// (-H) Gram points found in the cache
+	uint64_t	CacheGramMisses;	// ... and computed
+	uint64_t	CacheHits;		// (-H) Gram intervals (and single samples) found in the cache
+	uint64_t	CacheMisses;	// ... and computed
+	bool		IndexTried;		// T/F: (-I) the first Gram point was looked for in the index
+	bool		IndexUsed;		// T/F: ... and located from an index entry
+	uint64_t	IndexN;			// ... its 'n'
+	uint64_t	IndexFrom;		// ... and the 'n' of the entry
+}; 
+
+// -------------------------------------------------------------------
+// With -Z, a zero crossing between samples kLo and kHi (see HardyT),
+// located by ZeroWindow.
+// -------------------------------------------------------------------
+struct TURZERO {
+	int			kLo;
+	int			kHi;
+	mpfr_t		t;				// the zero
+	double		hzValue;		// Hardy Z at the latest point tried
+	int			Evals;			// Hardy Z values computed
+	bool		Ok;				// T/F: located to within 10^-ZeroDigits
+};
+
+// -------------------------------------------------------------------
+// Everything one Turing computation works on lives in its TURCTX
+// (see TuringCtxNew), so several computations can run at once in one
+// process.  The HardyZWithCount callbacks have only an int CallerID,
+// so the context's slot in a table of contexts travels in its high
+// bits (see TUR_CALLER and TuringCtxOf), and the callback's own index
+// in its low TUR_CTX_SHIFT bits.
+// -------------------------------------------------------------------
+struct TURCTX {
+	int					Slot;			// our slot in the context table
+	int					MaxGram;		// gList holds MaxGram + 1 entries
+	int					MaxCountZ;		// hInfo holds (MaxGram * MaxCountZ) + 2 entries
+	int					CountZ;			// number of Z(t) per Gram interval (excluding right endpoint)
+	struct GRAMLIST *	gList;
+	struct HARDYINFO *	hInfo;
+	mpfr_t				tBefore;		// 't' of hInfo[0], the sample before gList[0]
+	struct SWEEP		sweep;
+	bool *				Refined;		// T/F: sub-interval already refined (-a)
+	double				hzRefine[TUR_REFINE_POINTS + 2];
+	FILE *				fpBin;			// binary sample file (-B), if open
+	bool				BinFailed;		// T/F: unable to open, so do not try again
+	mpfr_t				BinBase;		// g(StartN): record t values are relative to this
+	struct TURBINRECORD *	BinRec;		// the records of one window (see BinWindow)
+	char *				tText;			// report text of each sample's 't' (see TextInterval)
+	int					OutputDP;		// decimals of 't' in tText (tur.OutputDP)
+	struct TURZERO *	Zeros;			// (-Z) (MaxGram * MaxCountZ) + 2 brackets, once needed
+	int					ZeroCount;		// (-Z) brackets in the current window
+	FILE *				fpOut;			// the report: stdout, or a -D client's socket
+	struct TURWRITER *	Writer;			// (-O) the writer thread, while a job runs
+	struct POOL *		Pool;			// (-w) the worker pool, while a job runs
+};
+
+#define	TUR_CALLER(ctx, n)	(((ctx)->Slot << TUR_CTX_SHIFT) | (n))
+
 int		ComputeTuring(struct TURING hz);
-int 	TuringReport(struct TURING tur);
+int		TuringOpen(struct TURING tur);
+int		TuringClose(void);
+struct TURCTX *	TuringCtxNew(int MaxGram, int MaxCountZ);
+int		TuringCtxFree(struct TURCTX *ctx);
+struct TURCTX *	TuringCtxOf(int CallerID);
+int		TuringJob(struct TURCTX *ctx, struct TURING tur);
+int		ComputeBatch(struct TURING tur);
+int		DaemonServe(struct TURING tur);
+int		PlanShards(struct TURING tur);
+int		PlanRun(struct TURING tur);
+int		WriterOpen(struct TURCTX *ctx);
+int		WriterReport(struct TURCTX *ctx, struct TURING tur);
+int		WriterPush(struct TURCTX *ctx, bool Drain);
+int		WriterClose(struct TURCTX *ctx);
+double	GramApprox(uint64_t n);
+int		GramWindow(struct TURCTX *ctx, struct TURING tur, mpfr_t nOfGram, mpfr_t Accuracy);
+int		GramNext(mpfr_t *Gram, mpfr_t Prev, mpfr_t n, mpfr_t Accuracy);
+int		GramFrom(mpfr_t *Gram, mpfr_t Prev, int64_t Steps, mpfr_t n, mpfr_t Accuracy);
+int		GramAccuracy(mpfr_t Accuracy);
+int		HardyZWindow(struct TURCTX *ctx, struct TURING tur);
+int		AnalyzeWindow(struct TURCTX *ctx, struct TURING tur);
+int		CarryWindow(struct TURCTX *ctx, struct TURING tur);
+int		PoolHardyZWindow(struct TURCTX *ctx, struct TURING tur);
+int		PoolClose(struct TURCTX *ctx);
+int		CpuCount(void);
+int		CpuAuto(struct TURING *pTur);
+int		CpuPlan(int *Cpu, int Max);
+int		CpuPin(int *Cpu, int Count, int First, int Width);
+int		CpuPinMain(int Threads);
+int		CpuSave(void);
+int		CpuRestore(void);
+int		RefineWindow(struct TURCTX *ctx, struct TURING tur);
+int		RefineReport(struct TURCTX *ctx, struct TURING tur);
+int		HardyT(struct TURCTX *ctx, mpfr_t t, struct TURING tur, int idx);
+int		CkptSignals(void);
+int		WriteCheckpoint(struct TURCTX *ctx, struct TURING tur);
+int		ReadCheckpoint(struct TURCTX *ctx, struct TURING tur, mpfr_t nOfGram);
+int		BinWindow(struct TURCTX *ctx, struct TURING tur);
+int		BinClose(struct TURCTX *ctx);
+int		RosserHardyZWindow(struct TURCTX *ctx, struct TURING tur);
+int		RosserScan(struct TURCTX *ctx, struct TURING tur, int Count);
+int		RosserInterval(struct TURCTX *ctx, struct TURING tur, int i);
+int		RosserReport(struct TURCTX *ctx);
+int		StatsInit(void);
+int		StatsBegin(int Which);
+int		StatsEnd(int Which);
+int		StatsThread(int Slot);
+int		StatsReport(bool Json);
+int		TimedHardyZ(mpfr_t t, mpfr_t Incr, int Count, int CallerID,
+			int (*Callback)(mpfr_t t, mpfr_t HardyZ, int i, int CallerID));
+int		MixedHardyZ(struct TURCTX *ctx, struct TURING tur, int idx);
+int		MixedInterval(struct TURCTX *ctx, struct TURING tur, int i);
+double	HardyZDouble(double t, double *pBound);
+long	MixedTerms(double Tau);
+int		GridInterval(struct TURCTX *ctx, struct TURING tur, int i);
+int		GridHardyZ(double t0, double h, int Count, double *Z, double *Bound);
+int		ClassHardyZWindow(struct TURCTX *ctx, struct TURING tur);
+int		ClassAnalyze(struct TURCTX *ctx, int i);
+int		ClassReport(struct TURCTX *ctx);
+int		TextInterval(struct TURCTX *ctx, struct TURING tur, int i);
+int		TextSample(struct TURCTX *ctx, int idx, mpfr_t t);
+int		CacheOpen(struct TURING tur);
+int		CacheClose(void);
+int		CacheGram(struct TURCTX *ctx, struct TURING tur, int i);
+int		CachePutGram(struct TURCTX *ctx, struct TURING tur, int i);
+int		CacheInterval(struct TURCTX *ctx, struct TURING tur, int i);
+int		CachePutInterval(struct TURCTX *ctx, struct TURING tur, int i);
+int		CachePoint(struct TURCTX *ctx, struct TURING tur, int idx);
+int		CachePutPoint(struct TURCTX *ctx, struct TURING tur, int idx);
+int		CacheReport(struct TURCTX *ctx, struct TURING tur);
+int		IndexOpen(struct TURING tur);
+int		IndexClose(void);
+int		IndexNearT(mpfr_t *n, mpfr_t t);
+int		IndexGram(struct TURCTX *ctx, mpfr_t *Gram, mpfr_t n, mpfr_t Accuracy);
+int		IndexReport(struct TURCTX *ctx, struct TURING tur);
+int		IndexBuild(struct TURING tur);
+int		ZeroWindow(struct TURCTX *ctx, struct TURING tur);
+int		ZeroAlloc(struct TURCTX *ctx);
+int		ZeroReport(struct TURCTX *ctx, struct TURING tur);
+int		ZeroDigitsMax(int Bits, double t);
+int 	TuringReport(struct TURCTX *ctx, struct TURING tur);
+int		SweepTally(struct TURCTX *ctx, struct TURING tur);
+int		SweepReport(struct TURCTX *ctx);
 int 	ComputeTuringK(mpfr_t Gram);
+uint64_t	ValidateSweepCount(char *sCount);
+int		AutoPrecision(char *sT, double tEnd);
+double	AutoEnd(struct TURING tur);
+int		ValidateRange(char *sValue, int Low, int High);
 
 int 	HardyZCallbackA(mpfr_t t, mpfr_t HardyZ, int i, int CallerID);
 int 	HardyZCallbackB(mpfr_t t, mpfr_t HardyZ, int i, int CallerID);
+int 	HardyZCallbackC(mpfr_t t, mpfr_t HardyZ, int i, int CallerID);
+int 	HardyZCallbackR(mpfr_t t, mpfr_t HardyZ, int i, int CallerID);
+int 	HardyZCallbackZ(mpfr_t t, mpfr_t HardyZ, int i, int CallerID);
 
@@ -0,0 +1,378 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+// turmerge: stitches together the binary Hardy Z sample files (see
+// turbin.h) of the shards planned by "turing -S".  The shards are put
+// in Gram point order, any gap or overlap between them is reported,
+// and where one shard ends and the next begins we check that both
+// computed the same Gram point, with the same Hardy Z.  The zero
+// counts, Gram points, even/odd checks and Lehmer flags are then
+// recomputed from the samples as one continuous sweep (so the samples
+// either side of each shard edge are taken together), and reported as
+// a sweep would report them.  Like turdump, it does not need libHGT
+// or MPFR.
+//
+// Usage: turmerge [file] [file] ...
+// -------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "turbin.h"
+
+#define	MERGE_Z_TOLERANCE	1e-6	// Hardy Z at a shared Gram point, relative to max(1, |Z|)
+#define	MERGE_T_TOLERANCE	1e-12	// 't' of a shared Gram point, relative
+
+struct SHARD {
+	const char *				sFile;
+	const struct TURBINHEADER *	pHeader;
+	const struct TURBINRECORD *	pRec;
+	uint64_t					CountGram;	// complete Gram intervals in the file
+};
+
+struct MERGE {
+	uint32_t	CountZ;
+	double		Prev;			// Hardy Z of the previous sample of the sweep
+	bool		PrevToward;		// T/F: the previous sample was moving toward zero
+	bool		EndBad;			// T/F: the last Gram point so far is bad (counted when a run ends)
+	uint64_t	Intervals;
+	uint64_t	ZerosFound;
+	uint64_t	BadGram;
+	uint64_t	BadParity;
+	uint64_t	Lehmer;
+	uint64_t	Gaps;
+	uint64_t	Overlaps;
+	uint64_t	Mismatches;
+};
+
+static const char *	MapFile(const char *sFile, size_t *pSize);
+static int			OpenShard(struct SHARD *pShard, const char *sFile);
+static int			CompareShards(const void *pA, const void *pB);
+static int			MergeBoundary(struct SHARD *pA, struct SHARD *pB, uint64_t i, struct MERGE *pM);
+static int			MergeInterval(struct SHARD *pShard, uint64_t i, struct MERGE *pM);
+static double		ShardT(struct SHARD *pShard, uint64_t k);
+
+
+int main( int argc, char *argv[] )
+{
+struct SHARD *	Shard;
+struct MERGE	m;
+struct SHARD *	pLast = NULL;
+uint64_t		NextN = 0, First, EndN, i;
+int				s, Count;
+
+if(argc < 2) {
+	printf("Usage: turmerge [file] [file] ...\n");
+	return(EXIT_FAILURE);
+	}
+Count = argc - 1;
+if((Shard = calloc((size_t) Count, sizeof(struct SHARD))) == NULL) {
+	printf("Out of memory \n");
+	return(EXIT_FAILURE);
+	}
+for(s = 0; s < Count; s++) {
+	if(OpenShard(&Shard[s], argv[s + 1]) != 1) {
+		return(EXIT_FAILURE);
+		}
+	}
+qsort(Shard, (size_t) Count, sizeof(struct SHARD), CompareShards);
+
+memset(&m, 0, sizeof(m));
+m.CountZ = Shard[0].pHeader->CountZ;
+for(s = 0; s < Count; s++) {
+	if(Shard[s].pHeader->CountZ != m.CountZ) {
+		printf("%s has %u samples per Gram interval, but %s has %u \n", Shard[s].sFile,
+			Shard[s].pHeader->CountZ, Shard[0].sFile, m.CountZ);
+		return(EXIT_FAILURE);
+		}
+	if(Shard[s].pHeader->Bits != Shard[0].pHeader->Bits) {
+		printf("Note: %s used %u bits, but %s used %u \n", Shard[s].sFile,
+			Shard[s].pHeader->Bits, Shard[0].sFile, Shard[0].pHeader->Bits);
+		}
+	}
+
+// -------------------------------------------------------------------
+// Walk the shards in order.  After a gap (or at the very start), the
+// sweep restarts from the shard's own sample before its first Gram
+// point.  Otherwise it carries on from the previous shard, whose last
+// sample is this shard's first Gram point (or, if they overlap, a
+// later one), and the intervals already seen are skipped.
+// -------------------------------------------------------------------
+for(s = 0; s < Count; s++) {
+	EndN = Shard[s].pHeader->StartN + Shard[s].CountGram;
+	printf("Shard %s: Gram intervals n = %ju through %ju (%ju intervals) \n", Shard[s].sFile,
+		(uintmax_t) Shard[s].pHeader->StartN, (uintmax_t) (EndN - 1), (uintmax_t) Shard[s].CountGram);
+	if(Shard[s].CountGram == 0) {
+		continue;
+		}
+	First = 0;
+	if(pLast == NULL || Shard[s].pHeader->StartN > NextN) {
+		if(pLast != NULL) {
+			printf("Gap: Gram intervals n = %ju through %ju are missing \n", (uintmax_t) NextN,
+				(uintmax_t) (Shard[s].pHeader->StartN - 1));
+			m.Gaps += 1;
+			m.BadGram += m.EndBad == true ? 1 : 0;
+			}
+		m.Prev = Shard[s].pRec[0].hzValue;
+		m.PrevToward = false;
+		MergeInterval(&Shard[s], UINT64_MAX, &m);
+		}
+	else {
+		First = NextN - Shard[s].pHeader->StartN;
+		if(First > 0) {
+			printf("Overlap: Gram intervals n = %ju through %ju are also in %s (which is used) \n",
+				(uintmax_t) Shard[s].pHeader->StartN,
+				(uintmax_t) ((EndN < NextN ? EndN : NextN) - 1), pLast->sFile);
+			m.Overlaps += 1;
+			}
+		if(First >= Shard[s].CountGram) {
+			continue;
+			}
+		MergeBoundary(pLast, &Shard[s], First, &m);
+		}
+	for(i = First; i < Shard[s].CountGram; i++) {
+		MergeInterval(&Shard[s], i, &m);
+		}
+	NextN = EndN;
+	pLast = &Shard[s];
+	}
+m.BadGram += m.EndBad == true ? 1 : 0;
+
+printf("\nMerged %ju Gram intervals, n = %ju through %ju, from %d shards: %ju gaps, %ju overlaps, %ju boundary mismatches \n",
+	(uintmax_t) m.Intervals, (uintmax_t) Shard[0].pHeader->StartN, (uintmax_t) (NextN - 1), Count,
+	(uintmax_t) m.Gaps, (uintmax_t) m.Overlaps, (uintmax_t) m.Mismatches);
+printf("Zeros Found = %ju, Bad Gram points = %ju, Even/Odd failures = %ju, Possible Lehmer = %ju \n",
+	(uintmax_t) m.ZerosFound, (uintmax_t) m.BadGram, (uintmax_t) m.BadParity, (uintmax_t) m.Lehmer);
+return((m.Gaps + m.Overlaps + m.Mismatches) == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+// *******************************************************************
+// Where shard A hands over to shard B at B's Gram interval i, A's last
+// sample and B's Gram point starting interval i are the same Gram
+// point, and must agree in 'n', in 't' and in Hardy Z.  When B starts
+// there (i = 0), B's sample just before that Gram point should also
+// have the sign of A's sample before it; if not, a pair of zeros lies
+// between samples and neither shard's count can be trusted.
+// *******************************************************************
+static int MergeBoundary(struct SHARD *pA, struct SHARD *pB, uint64_t i, struct MERGE *pM)
+{
+const struct TURBINRECORD *	pEndA;
+const struct TURBINRECORD *	pGramB;
+uint64_t					kA, kB;
+double						tA, tB;
+bool						Ok = true;
+
+kA = (pA->CountGram * pM->CountZ) + 1;
+kB = (i * pM->CountZ) + 1;
+pEndA  = &pA->pRec[kA];
+pGramB = &pB->pRec[kB];
+tA = ShardT(pA, kA);
+tB = ShardT(pB, kB);
+
+if(pEndA->n != pGramB->n || pEndA->Sub != 0 || pGramB->Sub != 0) {
+	printf("Boundary mismatch: %s ends at n = %ju, but %s has n = %ju there \n", pA->sFile,
+		(uintmax_t) pEndA->n, pB->sFile, (uintmax_t) pGramB->n);
+	Ok = false;
+	}
+else if(fabs(tA - tB) > MERGE_T_TOLERANCE * fabs(tA)) {
+	printf("Boundary mismatch at n = %ju: t = %.9f in %s, but %.9f in %s \n", (uintmax_t) pEndA->n,
+		tA, pA->sFile, tB, pB->sFile);
+	Ok = false;
+	}
+else if(pEndA->hzValue * pGramB->hzValue <= 0
+	|| fabs(pEndA->hzValue - pGramB->hzValue) > MERGE_Z_TOLERANCE * fmax(1, fabs(pEndA->hzValue))) {
+	printf("Boundary mismatch at n = %ju: Hardy Z = %.10f in %s, but %.10f in %s \n",
+		(uintmax_t) pEndA->n, pEndA->hzValue, pA->sFile, pGramB->hzValue, pB->sFile);
+	Ok = false;
+	}
+else if(i == 0 && pA->pRec[kA - 1].hzValue * pB->pRec[0].hzValue <= 0) {
+	printf("Boundary mismatch at n = %ju: the samples before the Gram point differ in sign (%.10f in %s, %.10f in %s) \n",
+		(uintmax_t) pEndA->n, pA->pRec[kA - 1].hzValue, pA->sFile, pB->pRec[0].hzValue, pB->sFile);
+	Ok = false;
+	}
+
+if(Ok == true) {
+	printf("Boundary at n = %ju (%s to %s): ok \n", (uintmax_t) pEndA->n, pA->sFile, pB->sFile);
+	}
+else {
+	pM->Mismatches += 1;
+	}
+return(Ok == true ? 1 : 0);
+}
+
+
+// *******************************************************************
+// We carry the sweep through Gram interval i of the shard: the zero
+// crossings and Lehmer flags of its samples (each against the sample
+// before it), whether its first Gram point is good, and whether its
+// zero count has the expected parity.  With i = UINT64_MAX, we only
+// take in the shard's first Gram point (after a restart).  This is
+// the same test as AnalyzeWindow and SweepTally in turing.
+// *******************************************************************
+static int MergeInterval(struct SHARD *pShard, uint64_t i, struct MERGE *pM)
+{
+const struct TURBINRECORD *	pRec;
+uint64_t					k, kFirst, kLast;
+double						Rise;
+bool						Toward, Cross, GoodStart, GoodEnd;
+int							Zeros = 0;
+
+if(i == UINT64_MAX) {
+	kFirst = kLast = 1;
+	}
+else {
+	kFirst = (i * pM->CountZ) + 2;
+	kLast  = ((i + 1) * pM->CountZ) + 1;
+	}
+GoodStart = (pShard->pRec[kFirst - 1].n % 2 == 0 ? 1 : -1) * pM->Prev > 0;
+
+for(k = kFirst; k <= kLast; k++) {
+	pRec = &pShard->pRec[k];
+	Rise   = pRec->hzValue - pM->Prev;
+	Toward = Rise * pRec->hzValue > 0 ? false : true;
+	Cross  = pRec->hzValue * pM->Prev < 0 ? true : false;
+	if(i != UINT64_MAX) {
+		Zeros += Cross == true ? 1 : 0;
+		if(Toward == false && Cross == false && pM->PrevToward == true) {
+			pM->Lehmer += 1;
+			}
+		}
+	pM->Prev = pRec->hzValue;
+	pM->PrevToward = Toward;
+	}
+if(i == UINT64_MAX) {
+	return(1);
+	}
+
+GoodEnd = (pShard->pRec[kLast].n % 2 == 0 ? 1 : -1) * pM->Prev > 0;
+pM->Intervals += 1;
+pM->ZerosFound += Zeros;
+if(GoodStart == false) {
+	pM->BadGram += 1;
+	}
+if((Zeros % 2 == 0) == (GoodStart == GoodEnd)) {
+	pM->BadParity += 1;
+	}
+pM->EndBad = GoodEnd == true ? false : true;
+return(1);
+}
+
+
+// *******************************************************************
+// We map a shard's file and check its header.  A shard that stopped
+// early holds fewer Gram intervals than planned; we use the complete
+// ones (each needs the Gram point that ends it).
+// *******************************************************************
+static int OpenShard(struct SHARD *pShard, const char *sFile)
+{
+const char *	pFile;
+size_t			Size;
+uint64_t		Count;
+
+if((pFile = MapFile(sFile, &Size)) == NULL) {
+	printf("Unable to read %s \n", sFile);
+	return(0);
+	}
+pShard->sFile = sFile;
+pShard->pHeader = (const struct TURBINHEADER *) pFile;
+pShard->pRec = (const struct TURBINRECORD *) (pFile + sizeof(struct TURBINHEADER));
+if(Size < sizeof(struct TURBINHEADER)
+	|| memcmp(pShard->pHeader->Magic, TURBIN_MAGIC, sizeof(pShard->pHeader->Magic)) != 0
+	|| pShard->pHeader->Version != TURBIN_VERSION
+	|| pShard->pHeader->HeaderSize != sizeof(struct TURBINHEADER)
+	|| pShard->pHeader->RecordSize != sizeof(struct TURBINRECORD)
+	|| pShard->pHeader->CountZ == 0) {
+	printf("The file %s is not a version %d binary sample file \n", sFile, TURBIN_VERSION);
+	return(0);
+	}
+
+Count = (Size - sizeof(struct TURBINHEADER)) / sizeof(struct TURBINRECORD);
+Count = Count < pShard->pHeader->CountRecords ? Count : pShard->pHeader->CountRecords;
+pShard->CountGram = Count >= 2 ? (Count - 2) / pShard->pHeader->CountZ : 0;
+if(pShard->CountGram < pShard->pHeader->CountGram) {
+	printf("Note: %s holds %ju of %ju Gram intervals (incomplete run?)\n", sFile,
+		(uintmax_t) pShard->CountGram, (uintmax_t) pShard->pHeader->CountGram);
+	}
+return(1);
+}
+
+
+static int CompareShards(const void *pA, const void *pB)
+{
+uint64_t	nA = ((const struct SHARD *) pA)->pHeader->StartN;
+uint64_t	nB = ((const struct SHARD *) pB)->pHeader->StartN;
+
+return(nA < nB ? -1 : (nA > nB ? 1 : 0));
+}
+
+
+// *******************************************************************
+// The 't' of record k, as a double.
+// *******************************************************************
+static double ShardT(struct SHARD *pShard, uint64_t k)
+{
+return(strtod(pShard->pHeader->sBaseT, NULL) + pShard->pRec[k].tOffset);
+}
+
+
+// *******************************************************************
+// We map the whole file read-only.  (On Windows, we just read it.)
+// *******************************************************************
+static const char * MapFile(const char *sFile, size_t *pSize)
+{
+#ifdef _WIN32
+FILE	*fp;
+char	*pData;
+long	Size;
+
+if((fp = fopen(sFile, "rb")) == NULL) {
+	return(NULL);
+	}
+fseek(fp, 0, SEEK_END);
+Size = ftell(fp);
+fseek(fp, 0, SEEK_SET);
+if(Size <= 0 || (pData = malloc((size_t) Size)) == NULL
+	|| fread(pData, (size_t) Size, 1, fp) != 1) {
+	fclose(fp);
+	return(NULL);
+	}
+fclose(fp);
+*pSize = (size_t) Size;
+return(pData);
+#else
+struct stat	st;
+void		*pData;
+int			fd;
+
+if((fd = open(sFile, O_RDONLY)) < 0) {
+	return(NULL);
+	}
+if(fstat(fd, &st) != 0 || st.st_size <= 0) {
+	close(fd);
+	return(NULL);
+	}
+pData = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+close(fd);
+if(pData == MAP_FAILED) {
+	return(NULL);
+	}
+*pSize = (size_t) st.st_size;
+return((const char *) pData);
+#endif
+}
@@ -0,0 +1,23 @@
+// -------------------------------------------------------------------
+// Program last modified October 17, 2026.
+// Copyright (c) 2025-2026 Terrence P. Murphy
+// MIT License -- see turing.c for details.
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+// The sample scan of AnalyzeWindow, on a structure-of-arrays copy of
+// the window's samples: Z holds the Hardy Z values contiguously, and
+// the TowardZero, ZeroCross and Lehmer flags are packed 64 samples to
+// a word (sample k is bit (k % 64) of word (k / 64)).  It is not part
+// of turing: AnalyzeWindow reads and writes hInfo directly, and the
+// copies in and out of hInfo cost about what the scan saves.  Only
+// bench/scan.c (make scanbench) uses it.
+// -------------------------------------------------------------------
+
+#define	TURSCAN_BITS			64
+#define	TURSCAN_WORDS(Count)	(((Count) + TURSCAN_BITS - 1) / TURSCAN_BITS)
+#define	TURSCAN_TEST(Bits, k)	((((Bits)[(k) / TURSCAN_BITS]) >> ((k) % TURSCAN_BITS)) & 1)
+
+int		ScanSamples(const double *Z, int64_t Count, double *Rise, uint64_t *Toward,
+			uint64_t *Cross, uint64_t *Lehmer);
+int		ScanCount(const uint64_t *Bits, int64_t First, int64_t Last);